@@ -40,6 +40,7 @@ $(OR_OUT_FILES): $(NETLIST) $(OR_DIR)/scripts/*.tcl $(OR_DIR)/src/*.tcl $(OR_DIR
 	PROJ_NAME="$(PROJ_NAME)" \
 	SAVE="$(SAVE)" \
 	REPORTS="$(REPORTS)" \
+	OR_OUT="$(OR_OUT)" \
 	PDK="$(CROC_ROOT)/ihp13/pdk" \
 	QT_QPA_PLATFORM=$$(if [ -z "$$DISPLAY" ]; then echo "offscreen"; else echo "$$QT_QPA_PLATFORM"; fi) \
 	$(OPENROAD) scripts/chip.tcl \
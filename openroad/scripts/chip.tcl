@@ -13,6 +13,12 @@ set netlist $::env(NETLIST)
 set top_design $::env(TOP_DESIGN)
 set report_dir $::env(REPORTS)
 set save_dir $::env(SAVE)
+# output directory (OR_OUT), relative to openroad/ by default
+if { [info exists ::env(OR_OUT)] } {
+    set out_dir $::env(OR_OUT)
+} else {
+    set out_dir out
+}
 set time [elapsed_run_time]
 set step_by_step_debug 0
 
@@ -342,18 +348,18 @@ estimate_parasitics -global_routing
 report_metrics "${log_id_str}_${proj_name}.final"
 
 utl::report "Write output"
-write_def                      out/${proj_name}.def
-write_verilog -include_pwr_gnd -remove_cells "$stdfill bondpad*" out/${proj_name}_lvs.v
-write_verilog                  out/${proj_name}.v
-write_db                       out/${proj_name}.odb
-write_sdc                      out/${proj_name}.sdc
+write_def                      ${out_dir}/${proj_name}.def
+write_verilog -include_pwr_gnd -remove_cells "$stdfill bondpad*" ${out_dir}/${proj_name}_lvs.v
+write_verilog                  ${out_dir}/${proj_name}.v
+write_db                       ${out_dir}/${proj_name}.odb
+write_sdc                      ${out_dir}/${proj_name}.sdc
 
 ## WARNING: Currently the extract_parasitics command removes metal patches (eg for min area)
 ## So if you want to use it, do so at the very end after writing out the def and odb files
 # define_process_corner -ext_model_index 0 X
 # extract_parasitics -ext_model_file IHP_rcx_patterns.rules
-# write_spef out/${proj_name}.spef
-# read_spef  out/${proj_name}.spef; # readback parasitics for OpenSTA
+# write_spef ${out_dir}/${proj_name}.spef
+# read_spef  ${out_dir}/${proj_name}.spef; # readback parasitics for OpenSTA
 # report_metrics "${log_id_str}_${proj_name}.extract"
 
 exit
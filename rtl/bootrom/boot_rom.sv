@@ -0,0 +1,201 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Generated by sw/bootrom/gen_bootrom.py from sw/bootrom/bootrom.S (make -C sw bootrom),
+// do not edit.
+
+`include "common_cells/registers.svh"
+
+// Boot ROM holding the UART boot loader, see sw/bootrom/bootrom.S
+// Read-only, answers one cycle after the request, writes return an error.
+module boot_rom #(
+  /// The OBI configuration for all ports.
+  parameter obi_pkg::obi_cfg_t ObiCfg    = obi_pkg::ObiDefaultConfig,
+  /// The request struct.
+  parameter type               obi_req_t = logic,
+  /// The response struct.
+  parameter type               obi_rsp_t = logic
+) (
+  input  logic clk_i,
+  input  logic rst_ni,
+
+  /// OBI request interface
+  input  obi_req_t obi_req_i,
+  /// OBI response interface
+  output obi_rsp_t obi_rsp_o
+);
+
+  localparam int unsigned NumWords  = 143;
+  localparam int unsigned AddrWidth = 8;
+
+  logic req_q, we_q;
+  logic [ObiCfg.IdWidth-1:0] id_q;
+  logic [AddrWidth-1:0] word_addr_q;
+  logic [ObiCfg.DataWidth-1:0] rom_data;
+
+  `FF(req_q,       obi_req_i.req,                   '0, clk_i, rst_ni)
+  `FF(we_q,        obi_req_i.a.we,                  '0, clk_i, rst_ni)
+  `FF(id_q,        obi_req_i.a.aid,                 '0, clk_i, rst_ni)
+  `FF(word_addr_q, obi_req_i.a.addr[2+:AddrWidth],  '0, clk_i, rst_ni)
+
+  always_comb begin
+    rom_data = '0;
+    unique case (word_addr_q)
+      8'h00: rom_data = 32'h1a40006f;
+      8'h01: rom_data = 32'h1a80006f;
+      8'h02: rom_data = 32'h1a40006f;
+      8'h03: rom_data = 32'h1a00006f;
+      8'h04: rom_data = 32'h19c0006f;
+      8'h05: rom_data = 32'h1980006f;
+      8'h06: rom_data = 32'h1940006f;
+      8'h07: rom_data = 32'h1900006f;
+      8'h08: rom_data = 32'h18c0006f;
+      8'h09: rom_data = 32'h1880006f;
+      8'h0a: rom_data = 32'h1840006f;
+      8'h0b: rom_data = 32'h1800006f;
+      8'h0c: rom_data = 32'h17c0006f;
+      8'h0d: rom_data = 32'h1780006f;
+      8'h0e: rom_data = 32'h1740006f;
+      8'h0f: rom_data = 32'h1700006f;
+      8'h10: rom_data = 32'h16c0006f;
+      8'h11: rom_data = 32'h1680006f;
+      8'h12: rom_data = 32'h1640006f;
+      8'h13: rom_data = 32'h1600006f;
+      8'h14: rom_data = 32'h15c0006f;
+      8'h15: rom_data = 32'h1580006f;
+      8'h16: rom_data = 32'h1540006f;
+      8'h17: rom_data = 32'h1500006f;
+      8'h18: rom_data = 32'h14c0006f;
+      8'h19: rom_data = 32'h1480006f;
+      8'h1a: rom_data = 32'h1440006f;
+      8'h1b: rom_data = 32'h1400006f;
+      8'h1c: rom_data = 32'h13c0006f;
+      8'h1d: rom_data = 32'h1380006f;
+      8'h1e: rom_data = 32'h1340006f;
+      8'h1f: rom_data = 32'h1300006f;
+      8'h20: rom_data = 32'h03002437;
+      8'h21: rom_data = 32'h00040223;
+      8'h22: rom_data = 32'h00a00513;
+      8'h23: rom_data = 32'h188000ef;
+      8'h24: rom_data = 32'h0c700293;
+      8'h25: rom_data = 32'h00540423;
+      8'h26: rom_data = 32'h02000293;
+      8'h27: rom_data = 32'h00540823;
+      8'h28: rom_data = 32'h04200513;
+      8'h29: rom_data = 32'h158000ef;
+      8'h2a: rom_data = 32'h04f00513;
+      8'h2b: rom_data = 32'h150000ef;
+      8'h2c: rom_data = 32'h04f00513;
+      8'h2d: rom_data = 32'h148000ef;
+      8'h2e: rom_data = 32'h05400513;
+      8'h2f: rom_data = 32'h140000ef;
+      8'h30: rom_data = 32'h00a00513;
+      8'h31: rom_data = 32'h138000ef;
+      8'h32: rom_data = 32'h0ec000ef;
+      8'h33: rom_data = 32'h06200293;
+      8'h34: rom_data = 32'h02550063;
+      8'h35: rom_data = 32'h06c00293;
+      8'h36: rom_data = 32'h02550a63;
+      8'h37: rom_data = 32'h06a00293;
+      8'h38: rom_data = 32'h0a550463;
+      8'h39: rom_data = 32'h03f00513;
+      8'h3a: rom_data = 32'h114000ef;
+      8'h3b: rom_data = 32'hfddff06f;
+      8'h3c: rom_data = 32'h0dc00fef;
+      8'h3d: rom_data = 32'h00050493;
+      8'h3e: rom_data = 32'h04b00513;
+      8'h3f: rom_data = 32'h100000ef;
+      8'h40: rom_data = 32'h00048513;
+      8'h41: rom_data = 32'h110000ef;
+      8'h42: rom_data = 32'hfc1ff06f;
+      8'h43: rom_data = 32'h00000a13;
+      8'h44: rom_data = 32'h0bc00fef;
+      8'h45: rom_data = 32'h00050913;
+      8'h46: rom_data = 32'h00050493;
+      8'h47: rom_data = 32'h0b000fef;
+      8'h48: rom_data = 32'h00050993;
+      8'h49: rom_data = 32'h00149293;
+      8'h4a: rom_data = 32'h01f4d493;
+      8'h4b: rom_data = 32'h0054e4b3;
+      8'h4c: rom_data = 32'h00a484b3;
+      8'h4d: rom_data = 32'h02098463;
+      8'h4e: rom_data = 32'h09400fef;
+      8'h4f: rom_data = 32'h00a92023;
+      8'h50: rom_data = 32'h00149293;
+      8'h51: rom_data = 32'h01f4d493;
+      8'h52: rom_data = 32'h0054e4b3;
+      8'h53: rom_data = 32'h00a484b3;
+      8'h54: rom_data = 32'h00490913;
+      8'h55: rom_data = 32'hffc98993;
+      8'h56: rom_data = 32'hfddff06f;
+      8'h57: rom_data = 32'h07000fef;
+      8'h58: rom_data = 32'h00e00293;
+      8'h59: rom_data = 32'h005a7a33;
+      8'h5a: rom_data = 32'h00951a63;
+      8'h5b: rom_data = 32'h000a1863;
+      8'h5c: rom_data = 32'h04f00513;
+      8'h5d: rom_data = 32'h088000ef;
+      8'h5e: rom_data = 32'hf51ff06f;
+      8'h5f: rom_data = 32'h04500513;
+      8'h60: rom_data = 32'h07c000ef;
+      8'h61: rom_data = 32'hf45ff06f;
+      8'h62: rom_data = 32'h04400fef;
+      8'h63: rom_data = 32'h00050493;
+      8'h64: rom_data = 32'h04a00513;
+      8'h65: rom_data = 32'h068000ef;
+      8'h66: rom_data = 32'h06c000ef;
+      8'h67: rom_data = 32'h0000100f;
+      8'h68: rom_data = 32'h00048067;
+      8'h69: rom_data = 32'h342022f3;
+      8'h6a: rom_data = 32'hec028ce3;
+      8'h6b: rom_data = 32'h10500073;
+      8'h6c: rom_data = 32'hffdff06f;
+      8'h6d: rom_data = 32'h01444283;
+      8'h6e: rom_data = 32'h005a6a33;
+      8'h6f: rom_data = 32'h0012f293;
+      8'h70: rom_data = 32'hfe028ae3;
+      8'h71: rom_data = 32'h00044503;
+      8'h72: rom_data = 32'h00008067;
+      8'h73: rom_data = 32'hfe9ff0ef;
+      8'h74: rom_data = 32'h00050313;
+      8'h75: rom_data = 32'hfe1ff0ef;
+      8'h76: rom_data = 32'h00851513;
+      8'h77: rom_data = 32'h00a36333;
+      8'h78: rom_data = 32'hfd5ff0ef;
+      8'h79: rom_data = 32'h01051513;
+      8'h7a: rom_data = 32'h00a36333;
+      8'h7b: rom_data = 32'hfc9ff0ef;
+      8'h7c: rom_data = 32'h01851513;
+      8'h7d: rom_data = 32'h00a36533;
+      8'h7e: rom_data = 32'h000f8067;
+      8'h7f: rom_data = 32'h00a40023;
+      8'h80: rom_data = 32'h00008067;
+      8'h81: rom_data = 32'h01444283;
+      8'h82: rom_data = 32'h0402f293;
+      8'h83: rom_data = 32'hfe028ce3;
+      8'h84: rom_data = 32'h00008067;
+      8'h85: rom_data = 32'h00008393;
+      8'h86: rom_data = 32'hfedff0ef;
+      8'h87: rom_data = 32'h08000293;
+      8'h88: rom_data = 32'h00540623;
+      8'h89: rom_data = 32'h00a40023;
+      8'h8a: rom_data = 32'h00855293;
+      8'h8b: rom_data = 32'h00540223;
+      8'h8c: rom_data = 32'h00300293;
+      8'h8d: rom_data = 32'h00540623;
+      8'h8e: rom_data = 32'h00038067;
+      default: rom_data = '0;
+    endcase
+  end
+
+  // A channel:
+  assign obi_rsp_o.gnt = obi_req_i.req;
+  // R channel:
+  assign obi_rsp_o.rvalid = req_q;
+  assign obi_rsp_o.r.rdata = rom_data;
+  assign obi_rsp_o.r.rid = id_q;
+  assign obi_rsp_o.r.err = we_q;
+  assign obi_rsp_o.r.r_optional = '0;
+
+endmodule
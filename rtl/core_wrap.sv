@@ -47,6 +47,20 @@ module core_wrap import croc_pkg::*; #() (
   // lowest 8 bits are ignored internally
   logic[31:0] ibex_boot_addr;
   assign ibex_boot_addr = boot_addr_i & 32'hFFFFFF00; 
+
+  // CORE_RV32M and CORE_RV32B select the multiplier and bit-manipulation extensions by their
+  // cve2_pkg name (e.g. RV32MFast), the software then needs a matching -march
+`ifdef CORE_RV32M
+  localparam cve2_pkg::rv32m_e CoreRV32M = cve2_pkg::`CORE_RV32M;
+`else
+  localparam cve2_pkg::rv32m_e CoreRV32M = cve2_pkg::RV32MNone;
+`endif
+`ifdef CORE_RV32B
+  localparam cve2_pkg::rv32b_e CoreRV32B = cve2_pkg::`CORE_RV32B;
+`else
+  localparam cve2_pkg::rv32b_e CoreRV32B = cve2_pkg::RV32BNone;
+`endif
+
 // ifdef ordered according to priority
 `ifdef TRACE_EXECUTION
   cve2_core_tracing #(
@@ -59,8 +73,8 @@ module core_wrap import croc_pkg::*; #() (
     .MHPMCounterNum     ( 0                   ),
     .MHPMCounterWidth   ( 40                  ),
     .RV32E              ( 0                   ),
-    .RV32M              ( cve2_pkg::RV32MNone ),
-    .RV32B              ( cve2_pkg::RV32BNone ),
+    .RV32M              ( CoreRV32M           ),
+    .RV32B              ( CoreRV32B           ),
     .DbgTriggerEn       ( 1'b1                ),
     .DbgHwBreakNum      ( 1                   ),
     .DmHaltAddr         ( DebugAddrOffset + dm::HaltAddress[31:0]      ),
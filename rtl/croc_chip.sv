@@ -21,6 +21,7 @@ module croc_chip import croc_pkg::*; #() (
 
   input  wire fetch_en_i,
   output wire status_o,
+  input  wire bootmode_i,
 
   inout  wire gpio0_io,
   inout  wire gpio1_io,
@@ -54,7 +55,6 @@ module croc_chip import croc_pkg::*; #() (
   inout  wire gpio29_io,
   inout  wire gpio30_io,
   inout  wire gpio31_io,
-  output wire unused0_o,
   output wire unused1_o,
   output wire unused2_o,
   output wire unused3_o
@@ -72,6 +72,7 @@ module croc_chip import croc_pkg::*; #() (
 
     logic soc_fetch_en_i;
     logic soc_status_o;
+    logic soc_bootmode_i;
 
     localparam int unsigned GpioCount = 32;
 
@@ -95,6 +96,7 @@ module croc_chip import croc_pkg::*; #() (
 
     sg13g2_IOPadIn        pad_fetch_en_i   (.pad(fetch_en_i),   .p2c(soc_fetch_en_i));
     sg13g2_IOPadOut16mA   pad_status_o     (.pad(status_o),     .c2p(soc_status_o));
+    sg13g2_IOPadIn        pad_bootmode_i   (.pad(bootmode_i),   .p2c(soc_bootmode_i));
 
     sg13g2_IOPadInOut30mA pad_gpio0_io     (.pad(gpio0_io),     .c2p(soc_gpio_o[0]),  .p2c(soc_gpio_i[0]),   .c2p_en(soc_gpio_out_en_o[0]));
     sg13g2_IOPadInOut30mA pad_gpio1_io     (.pad(gpio1_io),     .c2p(soc_gpio_o[1]),  .p2c(soc_gpio_i[1]),   .c2p_en(soc_gpio_out_en_o[1]));
@@ -128,7 +130,6 @@ module croc_chip import croc_pkg::*; #() (
     sg13g2_IOPadInOut30mA pad_gpio29_io    (.pad(gpio29_io),    .c2p(soc_gpio_o[29]), .p2c(soc_gpio_i[29]),  .c2p_en(soc_gpio_out_en_o[29]));
     sg13g2_IOPadInOut30mA pad_gpio30_io    (.pad(gpio30_io),    .c2p(soc_gpio_o[30]), .p2c(soc_gpio_i[30]),  .c2p_en(soc_gpio_out_en_o[30]));
     sg13g2_IOPadInOut30mA pad_gpio31_io    (.pad(gpio31_io),    .c2p(soc_gpio_o[31]), .p2c(soc_gpio_i[31]),  .c2p_en(soc_gpio_out_en_o[31]));
-    sg13g2_IOPadOut16mA pad_unused0_o      (.pad(unused0_o),    .c2p(soc_status_o));
     sg13g2_IOPadOut16mA pad_unused1_o      (.pad(unused1_o),    .c2p(soc_status_o));
     sg13g2_IOPadOut16mA pad_unused2_o      (.pad(unused2_o),    .c2p(soc_status_o));
     sg13g2_IOPadOut16mA pad_unused3_o      (.pad(unused3_o),    .c2p(soc_status_o));
@@ -163,6 +164,7 @@ module croc_chip import croc_pkg::*; #() (
     .testmode_i     ( soc_testmode_i ),
     .fetch_en_i     ( soc_fetch_en_i ),
     .status_o       ( soc_status_o   ),
+    .bootmode_i     ( soc_bootmode_i ),
 
     .jtag_tck_i     ( soc_jtag_tck_i   ),
     .jtag_tdi_i     ( soc_jtag_tdi_i   ),
@@ -5,6 +5,8 @@
 // Authors:
 // - Philippe Sauter <phsauter@iis.ee.ethz.ch>
 
+`include "common_cells/registers.svh"
+
 module croc_domain import croc_pkg::*; #(
   parameter int unsigned GpioCount = 16
 ) (
@@ -13,6 +15,7 @@ module croc_domain import croc_pkg::*; #(
   input  logic      ref_clk_i,
   input  logic      testmode_i,
   input  logic      fetch_en_i,
+  input  logic      bootmode_i, // croc_pkg::bootmode_e
 
   input  logic      jtag_tck_i,
   input  logic      jtag_tdi_i,
@@ -69,14 +72,18 @@ module croc_domain import croc_pkg::*; #(
   // Manager buses into crossbar
   // ----------------------------
 
-  // Core instr bus
+  // Core instr bus (core side of the loop cache)
+  mgr_obi_req_t core_fetch_obi_req;
+  mgr_obi_rsp_t core_fetch_obi_rsp;
+  assign core_fetch_obi_req.a.aid = '0;
+  assign core_fetch_obi_req.a.we = '0;
+  assign core_fetch_obi_req.a.be = '1;
+  assign core_fetch_obi_req.a.wdata = '0;
+  assign core_fetch_obi_req.a.a_optional = '0;
+
+  // Core instr bus (crossbar side of the loop cache)
   mgr_obi_req_t core_instr_obi_req;
   mgr_obi_rsp_t core_instr_obi_rsp;
-  assign core_instr_obi_req.a.aid = '0;
-  assign core_instr_obi_req.a.we = '0;
-  assign core_instr_obi_req.a.be = '1;
-  assign core_instr_obi_req.a.wdata = '0;
-  assign core_instr_obi_req.a.a_optional = '0;
 
   // Core data bus
   mgr_obi_req_t core_data_obi_req;
@@ -156,6 +163,14 @@ module croc_domain import croc_pkg::*; #(
   // Timer periph bus
   sbr_obi_req_t timer_obi_req;
   sbr_obi_rsp_t timer_obi_rsp;
+
+  // Performance counter periph bus
+  sbr_obi_req_t perf_obi_req;
+  sbr_obi_rsp_t perf_obi_rsp;
+
+  // Boot ROM periph bus
+  sbr_obi_req_t bootrom_obi_req;
+  sbr_obi_rsp_t bootrom_obi_rsp;
   
   // Fanout to individual peripherals
   assign error_obi_req                     = all_periph_obi_req[PeriphError];
@@ -170,6 +185,10 @@ module croc_domain import croc_pkg::*; #(
   assign all_periph_obi_rsp[PeriphGpio]    = gpio_obi_rsp;
   assign timer_obi_req                     = all_periph_obi_req[PeriphTimer];
   assign all_periph_obi_rsp[PeriphTimer]   = timer_obi_rsp;
+  assign perf_obi_req                      = all_periph_obi_req[PeriphPerf];
+  assign all_periph_obi_rsp[PeriphPerf]    = perf_obi_rsp;
+  assign bootrom_obi_req                   = all_periph_obi_req[PeriphBootRom];
+  assign all_periph_obi_rsp[PeriphBootRom] = bootrom_obi_rsp;
 
 
   // -----------------
@@ -187,12 +206,12 @@ module croc_domain import croc_pkg::*; #(
 
     .boot_addr_i      ( boot_addr   ),
 
-    .instr_req_o      ( core_instr_obi_req.req     ),
-    .instr_gnt_i      ( core_instr_obi_rsp.gnt     ),
-    .instr_rvalid_i   ( core_instr_obi_rsp.rvalid  ),
-    .instr_addr_o     ( core_instr_obi_req.a.addr  ),
-    .instr_rdata_i    ( core_instr_obi_rsp.r.rdata ),
-    .instr_err_i      ( core_instr_obi_rsp.r.err   ),
+    .instr_req_o      ( core_fetch_obi_req.req     ),
+    .instr_gnt_i      ( core_fetch_obi_rsp.gnt     ),
+    .instr_rvalid_i   ( core_fetch_obi_rsp.rvalid  ),
+    .instr_addr_o     ( core_fetch_obi_req.a.addr  ),
+    .instr_rdata_i    ( core_fetch_obi_rsp.r.rdata ),
+    .instr_err_i      ( core_fetch_obi_rsp.r.err   ),
 
     .data_req_o       ( core_data_obi_req.req      ),
     .data_gnt_i       ( core_data_obi_rsp.gnt      ),
@@ -210,6 +229,31 @@ module croc_domain import croc_pkg::*; #(
     .core_busy_o     ( core_busy_o )
   );
 
+  // -----------------
+  // Loop Cache
+  // -----------------
+  logic loop_cache_hit, loop_cache_miss;
+
+  loop_cache #(
+    .obi_req_t ( mgr_obi_req_t     ),
+    .obi_rsp_t ( mgr_obi_rsp_t     ),
+    .NumWords  ( LoopCacheNumWords ),
+    .NumSnoop  ( 3                 ),
+    .CacheBase ( SramBaseAddr      ),
+    .CacheSize ( SramAddrRange     )
+  ) i_loop_cache (
+    .clk_i,
+    .rst_ni,
+    .core_req_i  ( core_fetch_obi_req ),
+    .core_rsp_o  ( core_fetch_obi_rsp ),
+    .mem_req_o   ( core_instr_obi_req ),
+    .mem_rsp_i   ( core_instr_obi_rsp ),
+    .snoop_req_i ( {core_data_obi_req, dbg_req_obi_req, user_mgr_obi_req_i} ),
+    .snoop_rsp_i ( {core_data_obi_rsp, dbg_req_obi_rsp, user_mgr_obi_rsp_o} ),
+    .hit_o       ( loop_cache_hit     ),
+    .miss_o      ( loop_cache_miss    )
+  );
+
   // -----------------
   // Debug Module
   // -----------------
@@ -304,6 +348,19 @@ module croc_domain import croc_pkg::*; #(
   // Main Interconnect
   // -----------------
 
+  // SRAM bank interleaving (see croc_pkg::sram_bank_remap), responses pass unchanged
+  mgr_obi_req_t [NumXbarManagers-1:0] xbar_mgr_obi_req;
+  mgr_obi_rsp_t [NumXbarManagers-1:0] xbar_mgr_obi_rsp;
+
+  assign {core_instr_obi_rsp, core_data_obi_rsp, dbg_req_obi_rsp, user_mgr_obi_rsp_o} = xbar_mgr_obi_rsp;
+
+  always_comb begin
+    xbar_mgr_obi_req = {core_instr_obi_req, core_data_obi_req, dbg_req_obi_req, user_mgr_obi_req_i};
+    for (int unsigned i = 0; i < NumXbarManagers; i++) begin
+      xbar_mgr_obi_req[i].a.addr = sram_bank_remap(xbar_mgr_obi_req[i].a.addr);
+    end
+  end
+
   obi_xbar #(
     .SbrPortObiCfg      ( MgrObiCfg        ),
     .MgrPortObiCfg      ( SbrObiCfg        ),
@@ -325,8 +382,8 @@ module croc_domain import croc_pkg::*; #(
     .rst_ni,
     .testmode_i,
 
-    .sbr_ports_req_i  ( {core_instr_obi_req, core_data_obi_req, dbg_req_obi_req, user_mgr_obi_req_i } ), // from managers towards subordinates
-    .sbr_ports_rsp_o  ( {core_instr_obi_rsp, core_data_obi_rsp, dbg_req_obi_rsp, user_mgr_obi_rsp_o } ),
+    .sbr_ports_req_i  ( xbar_mgr_obi_req ), // from managers towards subordinates
+    .sbr_ports_rsp_o  ( xbar_mgr_obi_rsp ),
     .mgr_ports_req_o  ( all_sbr_obi_req ), // connections to subordinates
     .mgr_ports_rsp_i  ( all_sbr_obi_rsp ),
 
@@ -367,6 +424,7 @@ module croc_domain import croc_pkg::*; #(
       .rdata_i ( bank_rdata )
     );
 
+    // the bank select bits are above the word address after the remapping in front of the xbar
     assign bank_word_addr = bank_byte_addr[SbrObiCfg.AddrWidth-1:2];
 
     tc_sram_impl #(
@@ -501,10 +559,23 @@ module croc_domain import croc_pkg::*; #(
 
   soc_ctrl_reg_pkg::soc_ctrl_reg2hw_t soc_ctrl_reg2hw;
   soc_ctrl_reg_pkg::soc_ctrl_hw2reg_t soc_ctrl_hw2reg;
-  assign fetch_enable    = soc_ctrl_reg2hw.fetchen.q | fetch_en_i;
-  assign boot_addr       = soc_ctrl_reg2hw.bootaddr.q;
+  bootmode_e bootmode;
+  logic [2:0] bootmode_sample_q;
+
+  // BOOTMODE follows the pin for the first cycles after reset (covering the synchronizer in
+  // croc_soc), then software or the debugger may change it
+  `FF(bootmode_sample_q, {bootmode_sample_q[1:0], 1'b1}, '0, clk_i, rst_ni)
+  always_comb begin
+    soc_ctrl_hw2reg             = '0;
+    soc_ctrl_hw2reg.bootmode.d  = bootmode_i;
+    soc_ctrl_hw2reg.bootmode.de = !bootmode_sample_q[2];
+  end
+
+  // UART boot starts the core in the boot ROM without waiting for fetch enable
+  assign bootmode        = bootmode_e'(soc_ctrl_reg2hw.bootmode.q);
+  assign fetch_enable    = soc_ctrl_reg2hw.fetchen.q | fetch_en_i | (bootmode == Uart);
+  assign boot_addr       = (bootmode == Uart) ? BootRomAddrOffset : soc_ctrl_reg2hw.bootaddr.q;
   assign sram_impl       = soc_ctrl_reg2hw.sram_dly;
-  assign soc_ctrl_hw2reg = '0;
 
   soc_ctrl_reg_top #(
     .reg_req_t       ( reg_req_t    ),
@@ -622,4 +693,39 @@ module croc_domain import croc_pkg::*; #(
   assign timer_obi_rsp.r.err        = 1'b0;
   assign timer_obi_rsp.r.r_optional = 1'b0;
 
+  // Performance counters of the main xbar managers
+  perf_counters #(
+    .ObiCfg      ( SbrObiCfg       ),
+    .obi_req_t   ( sbr_obi_req_t   ),
+    .obi_rsp_t   ( sbr_obi_rsp_t   ),
+    .mgr_req_t   ( mgr_obi_req_t   ),
+    .mgr_rsp_t   ( mgr_obi_rsp_t   ),
+    .NumMgr      ( NumXbarManagers ),
+    .NumSbr      ( NumXbarSbr      ),
+    .NumRules    ( NumXbarSbrRules ),
+    .addr_rule_t ( addr_map_rule_t ),
+    .AddrMap     ( croc_addr_map   ),
+    .NumEvents   ( 2               )
+  ) i_perf_counters (
+    .clk_i,
+    .rst_ni,
+    .mgr_req_i ( xbar_mgr_obi_req ),
+    .mgr_rsp_i ( xbar_mgr_obi_rsp ),
+    .event_i   ( {loop_cache_miss, loop_cache_hit} ),
+    .obi_req_i ( perf_obi_req     ),
+    .obi_rsp_o ( perf_obi_rsp     )
+  );
+
+  // Boot ROM (UART boot loader)
+  boot_rom #(
+    .ObiCfg    ( SbrObiCfg     ),
+    .obi_req_t ( sbr_obi_req_t ),
+    .obi_rsp_t ( sbr_obi_rsp_t )
+  ) i_boot_rom (
+    .clk_i,
+    .rst_ni,
+    .obi_req_i ( bootrom_obi_req ),
+    .obi_rsp_o ( bootrom_obi_rsp )
+  );
+
 endmodule
@@ -31,8 +31,11 @@ package croc_pkg;
     version       : JtagCrocVersion
   };
 
+  // Jtag: the core waits for fetch enable and starts at soc_ctrl BOOTADDR (the debugger loads
+  // the program). Uart: the core starts right away in the boot ROM (sw/bootrom/bootrom.S).
   typedef enum logic {
-    Jtag = 1'b0
+    Jtag = 1'b0,
+    Uart = 1'b1
   } bootmode_e;
 
   // Number of additional interrupts coming into croc_domain and going to the core
@@ -60,17 +63,56 @@ package croc_pkg;
   localparam bit [31:0]   PeriphAddrRange   = 32'h1000_0000;
 
   localparam bit [31:0]   SramBaseAddr      = 32'h1000_0000;
+  // NUM_SRAM_BANKS and SRAM_BANK_WORDS override the SRAM size (e.g. for sw/ and sweep/), the
+  // technology needs a macro of that size (ihp13/tc_sram_impl.sv)
+`ifdef NUM_SRAM_BANKS
+  localparam int unsigned NumSramBanks      = `NUM_SRAM_BANKS;
+`else
   localparam int unsigned NumSramBanks      = 32'd2;
+`endif
+`ifdef SRAM_BANK_WORDS
+  localparam int unsigned SramBankNumWords  = `SRAM_BANK_WORDS;
+`else
   localparam int unsigned SramBankNumWords  = 512;
+`endif
   localparam int unsigned SramBankAddrWidth = cf_math_pkg::idx_width(SramBankNumWords);
   localparam int unsigned SramAddrRange     = NumSramBanks*SramBankNumWords*4;
 
+  // Bank interleaving: 0 maps the banks one after the other, otherwise the number of bytes
+  // (power of two, at least 4) in one bank before the next bank follows, e.g. 4 alternates the
+  // banks every word. Interleaving needs a power of two number of banks.
+`ifdef SRAM_INTERLEAVE
+  localparam int unsigned SramBankInterleave = `SRAM_INTERLEAVE;
+`else
+  localparam int unsigned SramBankInterleave = 0;
+`endif
+  localparam int unsigned SramAddrWidth      = $clog2(SramAddrRange);
+  localparam int unsigned SramBankSelWidth   = $clog2(NumSramBanks);
+  localparam int unsigned SramBankSelLsb     = (SramBankInterleave == 0) ?
+                                               SramAddrWidth - SramBankSelWidth :
+                                               $clog2(SramBankInterleave);
+
+  // Loop cache in front of the core instruction port: number of cached words (power of two,
+  // e.g. 8 to 32), 0 removes the cache.
+`ifdef LOOP_CACHE_WORDS
+  localparam int unsigned LoopCacheNumWords = `LOOP_CACHE_WORDS;
+`else
+  localparam int unsigned LoopCacheNumWords = 0;
+`endif
+
   localparam bit [31:0]   UserBaseAddr      = 32'h2000_0000;
   localparam bit [31:0]   UserAddrRange     = 32'h6000_0000;
 
   localparam int unsigned NumCrocDomainSubordinates = 2 + NumSramBanks; // Peripherals + Memory + User Domain
   
   localparam int unsigned NumXbarManagers = 4; // Debug module, Core Instr, Core Data, User Domain
+  // Manager port indices of the main xbar
+  typedef enum int {
+    XbarMgrUser  = 0,
+    XbarMgrDebug = 1,
+    XbarMgrData  = 2,
+    XbarMgrInstr = 3
+  } croc_xbar_managers_e;
   localparam int unsigned NumXbarSbrRules = NumCrocDomainSubordinates; // number of address rules in the decoder
   localparam int unsigned NumXbarSbr      = NumXbarSbrRules + 1; // additional OBI error, used for signal arrays
 
@@ -103,6 +145,22 @@ package croc_pkg;
 
   localparam addr_map_rule_t [NumXbarSbrRules-1:0] croc_addr_map = gen_xbar_addr_rules();
 
+  // The xbar decodes the banks as contiguous ranges. Manager addresses into the SRAM are
+  // remapped before it by moving the bank select bits to the top of the SRAM offset, the
+  // remaining bits form the word address inside the bank. Identity for contiguous banks.
+  function automatic logic [31:0] sram_bank_remap(logic [31:0] addr);
+    logic [31:0] ret = addr;
+    if (addr >= SramBaseAddr && addr < SramBaseAddr + SramAddrRange) begin
+      for (int unsigned i = SramBankSelLsb; i < SramAddrWidth; i++) begin
+        if (i < SramAddrWidth - SramBankSelWidth)
+          ret[i] = addr[i + SramBankSelWidth];
+        else
+          ret[i] = addr[i - (SramAddrWidth - SramBankSelWidth) + SramBankSelLsb];
+      end
+    end
+    return ret;
+  endfunction
+
 
   /////////////////////////////
   // Peripheral address map ///
@@ -111,6 +169,9 @@ package croc_pkg;
   localparam bit [31:0] DebugAddrOffset   = 32'h0000_0000;
   localparam bit [31:0] DebugAddrRange    = 32'h0004_0000;
 
+  localparam bit [31:0] BootRomAddrOffset = 32'h0200_0000;
+  localparam bit [31:0] BootRomAddrRange  = 32'h0000_1000;
+
   localparam bit [31:0] SocCtrlAddrOffset = 32'h0300_0000;
   localparam bit [31:0] SocCtrlAddrRange  = 32'h0000_1000;
 
@@ -123,7 +184,10 @@ package croc_pkg;
   localparam bit [31:0] TimerAddrOffset   = 32'h0300_A000;
   localparam bit [31:0] TimerAddrRange    = 32'h0000_1000;
 
-  localparam int unsigned NumPeriphRules  = 5;
+  localparam bit [31:0] PerfAddrOffset    = 32'h0300_B000;
+  localparam bit [31:0] PerfAddrRange     = 32'h0000_1000;
+
+  localparam int unsigned NumPeriphRules  = 7;
   localparam int unsigned NumPeriphs      = NumPeriphRules + 1; // additional OBI error
 
   // Enum for bus indices
@@ -133,7 +197,9 @@ package croc_pkg;
     PeriphSocCtrl  = 2,
     PeriphUart     = 3,
     PeriphGpio     = 4,
-    PeriphTimer    = 5
+    PeriphTimer    = 5,
+    PeriphPerf     = 6,
+    PeriphBootRom  = 7
   } periph_outputs_e;
 
   localparam addr_map_rule_t [NumPeriphRules-1:0] periph_addr_map = '{                                       // 0: OBI Error (default)
@@ -141,7 +207,9 @@ package croc_pkg;
     '{ idx: PeriphSocCtrl,  start_addr: SocCtrlAddrOffset,  end_addr: SocCtrlAddrOffset + SocCtrlAddrRange}, // 2: SoC control
     '{ idx: PeriphUart,     start_addr: UartAddrOffset,     end_addr: UartAddrOffset    + UartAddrRange},    // 3: UART
     '{ idx: PeriphGpio,     start_addr: GpioAddrOffset,     end_addr: GpioAddrOffset    + GpioAddrRange},    // 4: GPIO
-    '{ idx: PeriphTimer,    start_addr: TimerAddrOffset,    end_addr: TimerAddrOffset   + TimerAddrRange}    // 5: Timer
+    '{ idx: PeriphTimer,    start_addr: TimerAddrOffset,    end_addr: TimerAddrOffset   + TimerAddrRange},   // 5: Timer
+    '{ idx: PeriphPerf,     start_addr: PerfAddrOffset,     end_addr: PerfAddrOffset    + PerfAddrRange},    // 6: Performance counters
+    '{ idx: PeriphBootRom,  start_addr: BootRomAddrOffset,  end_addr: BootRomAddrOffset + BootRomAddrRange}  // 7: Boot ROM
   };
 
   // OBI is configured as 32 bit data, 32 bit address width
@@ -13,6 +13,7 @@ module croc_soc import croc_pkg::*; #(
   input  logic ref_clk_i,
   input  logic testmode_i,
   input  logic fetch_en_i,
+  input  logic bootmode_i, // croc_pkg::bootmode_e, sampled after reset
   output logic status_o,
 
   input  logic jtag_tck_i,
@@ -29,7 +30,7 @@ module croc_soc import croc_pkg::*; #(
   output logic [GpioCount-1:0] gpio_out_en_o // Output enable signal; 0 -> input, 1 -> output
 );
 
-  logic synced_rst_n, synced_fetch_en;
+  logic synced_rst_n, synced_fetch_en, synced_bootmode;
 
   rstgen i_rstgen (
     .clk_i,
@@ -49,6 +50,16 @@ module croc_soc import croc_pkg::*; #(
       .serial_o ( synced_fetch_en )
     );
 
+  sync #(
+      .STAGES     (    2 ),
+      .ResetValue ( 1'b0 )
+    ) i_bootmode_sync (
+      .clk_i,
+      .rst_ni   ( synced_rst_n    ),
+      .serial_i ( bootmode_i      ),
+      .serial_o ( synced_bootmode )
+    );
+
 // Connection between Croc_domain and User_domain: User Sbr, Croc Mgr
 sbr_obi_req_t user_sbr_obi_req;
 sbr_obi_rsp_t user_sbr_obi_rsp;
@@ -68,6 +79,7 @@ croc_domain #(
   .ref_clk_i,
   .testmode_i,
   .fetch_en_i ( synced_fetch_en ),
+  .bootmode_i ( synced_bootmode ),
 
   .jtag_tck_i,
   .jtag_tdi_i,
@@ -19,7 +19,9 @@ module gpio #(
     /// Number of synchronization stages for GPIO inputs.
     parameter int  NrSyncStages      = 2,
     /// The number of GPIOs
-    parameter int unsigned GpioCount = 16
+    parameter int unsigned GpioCount = 16,
+    /// Number of entries in the waveform FIFO
+    parameter int unsigned WaveDepth = 8
 ) (
     /// Primary input clock
     input  logic                 clk_i,
@@ -66,6 +68,10 @@ module gpio #(
 
   logic gpio_intrpt_pending;
 
+  // Waveform engine
+  gpio_wave_reg2hw_t wave_reg2hw;
+  gpio_wave_hw2reg_t wave_hw2reg;
+
   // Instantiate register file
   gpio_reg_top #(
     .obi_req_t(obi_req_t),
@@ -77,9 +83,63 @@ module gpio #(
     .obi_req_i,
     .obi_rsp_o,
     .reg2hw(reg2hw),
-    .hw2reg(hw2reg)
+    .hw2reg(hw2reg),
+    .wave_reg2hw(wave_reg2hw),
+    .wave_hw2reg(wave_hw2reg)
   );
 
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+  // Waveform Engine //
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  // Queued entries are applied to the masked OUT bits one every `period` cycles;
+  // the first entry after the FIFO ran empty is applied right away.
+  localparam int unsigned WaveAddrDepth = (WaveDepth > 1) ? $clog2(WaveDepth) : 1;
+
+  logic [GpioCount-1:0]     wave_data;
+  logic                     wave_full, wave_empty, wave_pop;
+  logic [WaveAddrDepth-1:0] wave_usage;
+  logic [15:0]              wave_cnt_d, wave_cnt_q;
+
+  `FF(wave_cnt_q, wave_cnt_d, '0, clk_i, rst_ni)
+
+  fifo_v3 #(
+    .FALL_THROUGH ( 1'b0      ),
+    .DATA_WIDTH   ( GpioCount ),
+    .DEPTH        ( WaveDepth )
+  ) i_wave_fifo (
+    .clk_i,
+    .rst_ni,
+    .flush_i    ( 1'b0                               ),
+    .testmode_i ( 1'b0                               ),
+    .full_o     ( wave_full                          ),
+    .empty_o    ( wave_empty                         ),
+    .usage_o    ( wave_usage                         ),
+    .data_i     ( wave_reg2hw.data[GpioCount-1:0]    ),
+    .push_i     ( wave_reg2hw.push & ~wave_full      ),
+    .data_o     ( wave_data                          ),
+    .pop_i      ( wave_pop                           )
+  );
+
+  always_comb begin
+    wave_pop   = 1'b0;
+    wave_cnt_d = wave_cnt_q;
+    if (wave_reg2hw.enable && !wave_empty) begin
+      if (wave_cnt_q == '0) begin
+        wave_pop   = 1'b1;
+        wave_cnt_d = (wave_reg2hw.period == '0) ? '0 : wave_reg2hw.period - 16'd1;
+      end else begin
+        wave_cnt_d = wave_cnt_q - 16'd1;
+      end
+    end else if (wave_empty) begin
+      wave_cnt_d = '0;
+    end
+  end
+
+  assign wave_hw2reg.full  = wave_full;
+  assign wave_hw2reg.empty = wave_empty;
+  assign wave_hw2reg.level = wave_full ? 16'(WaveDepth) : 16'(wave_usage);
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   // Internal GPIO Logic - HW //
   ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -133,17 +193,26 @@ module gpio #(
 
 
         //-----------------------------------------------------------------------------------------------
-        // Toggle
+        // Toggle and Waveform
         //-----------------------------------------------------------------------------------------------
 
         always_comb begin
-            hw2reg[idx].out       = '0;
+            logic out_next;
+            out_next              = reg2hw[idx].out;
             hw2reg[idx].out_valid = '0;
 
+            // waveform engine writes the masked OUT bits
+            if (wave_pop & wave_reg2hw.mask[idx]) begin
+                out_next              = wave_data[idx];
+                hw2reg[idx].out_valid = 1'b1;
+            end
+
             if (is_output & reg2hw[idx].toggle) begin
-                hw2reg[idx].out       = ~reg2hw[idx].out;
+                out_next              = ~out_next;
                 hw2reg[idx].out_valid = 1'b1;
             end
+
+            hw2reg[idx].out = out_next;
         end
 
 
@@ -42,6 +42,25 @@ package gpio_reg_pkg;
   } gpio_hw2reg_t;
 
 
+  //-----------------------------------------------------------------------------------------------
+  // Waveform engine (shared by all GPIOs, fields sized for the maximum of 32 GPIOs)
+  //-----------------------------------------------------------------------------------------------
+
+  typedef struct packed {
+    logic [15:0] period; // cycles between two applied entries (0 is treated as 1)
+    logic        enable;
+    logic [31:0] mask;   // outputs driven by the waveform entries
+    logic [31:0] data;   // entry to queue
+    logic        push;   // passthrough from OBI write, queues data in this cycle
+  } gpio_wave_reg2hw_t;
+
+  typedef struct packed {
+    logic [15:0] level;  // number of queued entries
+    logic        full;
+    logic        empty;
+  } gpio_wave_hw2reg_t;
+
+
   //-----------------------------------------------------------------------------------------------
   // Offsets
   //-----------------------------------------------------------------------------------------------
@@ -56,6 +75,20 @@ package gpio_reg_pkg;
   parameter logic [AddressWidth-1:0] GPIO_INTRPT_EN_OFFSET     = 11'h280;
   parameter logic [AddressWidth-1:0] GPIO_INTRPT_STATUS_OFFSET = 11'h300;
   parameter logic [AddressWidth-1:0] GPIO_INTRPT_EDGE_OFFSET   = 11'h380;
-  // Next feature uses address h380
+  // Write-1-to-set and write-1-to-clear aliases (reads return the aliased register)
+  parameter logic [AddressWidth-1:0] GPIO_DIR_SET_OFFSET       = 12'h400;
+  parameter logic [AddressWidth-1:0] GPIO_DIR_CLR_OFFSET       = 12'h480;
+  parameter logic [AddressWidth-1:0] GPIO_EN_SET_OFFSET        = 12'h500;
+  parameter logic [AddressWidth-1:0] GPIO_EN_CLR_OFFSET        = 12'h580;
+  parameter logic [AddressWidth-1:0] GPIO_OUT_SET_OFFSET       = 12'h600;
+  parameter logic [AddressWidth-1:0] GPIO_OUT_CLR_OFFSET       = 12'h680;
+  parameter logic [AddressWidth-1:0] GPIO_INTRPT_EN_SET_OFFSET = 12'h700;
+  parameter logic [AddressWidth-1:0] GPIO_INTRPT_EN_CLR_OFFSET = 12'h780;
+  // Waveform engine
+  parameter logic [AddressWidth-1:0] GPIO_WAVE_CFG_OFFSET      = 12'h800;
+  parameter logic [AddressWidth-1:0] GPIO_WAVE_MASK_OFFSET     = 12'h880;
+  parameter logic [AddressWidth-1:0] GPIO_WAVE_DATA_OFFSET     = 12'h900;
+  parameter logic [AddressWidth-1:0] GPIO_WAVE_STATUS_OFFSET   = 12'h980;
+  // Next feature uses address hA00
 
 endpackage
@@ -34,7 +34,11 @@ module gpio_reg_top import gpio_reg_pkg::*; #(
     /// Signals from registers to logic; one per GPIO
     output gpio_reg2hw_t [GpioCount-1:0] reg2hw,
     /// Signals from logic to registers; one per GPIO
-    input  gpio_hw2reg_t [GpioCount-1:0]  hw2reg
+    input  gpio_hw2reg_t [GpioCount-1:0]  hw2reg,
+    /// Waveform engine configuration and FIFO write port
+    output gpio_wave_reg2hw_t wave_reg2hw,
+    /// Waveform engine FIFO status
+    input  gpio_wave_hw2reg_t wave_hw2reg
 );
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -107,6 +111,21 @@ module gpio_reg_top import gpio_reg_pkg::*; #(
   
   gpio_reg_fields_t new_reg; // new value of regs if there is no OBI transaction
 
+  // waveform engine registers
+  logic [15:0] wave_period_d, wave_period_q;
+  logic        wave_enable_d, wave_enable_q;
+  logic [31:0] wave_mask_d, wave_mask_q;
+  logic        wave_push;
+  `FF(wave_period_q, wave_period_d, '0, clk_i, rst_ni)
+  `FF(wave_enable_q, wave_enable_d, '0, clk_i, rst_ni)
+  `FF(wave_mask_q, wave_mask_d, '0, clk_i, rst_ni)
+
+  assign wave_reg2hw.period = wave_period_q;
+  assign wave_reg2hw.enable = wave_enable_q;
+  assign wave_reg2hw.mask   = wave_mask_q;
+  assign wave_reg2hw.data   = obi_wdata;
+  assign wave_reg2hw.push   = wave_push;
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   // COMB LOGIC //
   ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -141,6 +160,10 @@ module gpio_reg_top import gpio_reg_pkg::*; #(
     new_reg    = reg_q;   // registers stay the same
     new_intrpt = '0;
     toggle_out = '0;
+    wave_period_d    = wave_period_q;
+    wave_enable_d    = wave_enable_q;
+    wave_mask_d      = wave_mask_q;
+    wave_push        = 1'b0;
 
     // control logic interaction for each GPIO
     for(int unsigned idx=0; idx < GpioCount; idx++) begin
@@ -192,6 +215,51 @@ module gpio_reg_top import gpio_reg_pkg::*; #(
             (~bit_mask & new_reg.intrpt_edge) | (bit_mask & obi_wdata[GpioCount-1:0]);
         end
 
+        GPIO_DIR_SET_OFFSET: begin
+          reg_d.dir = new_reg.dir | (bit_mask & obi_wdata[GpioCount-1:0]);
+        end
+
+        GPIO_DIR_CLR_OFFSET: begin
+          reg_d.dir = new_reg.dir & ~(bit_mask & obi_wdata[GpioCount-1:0]);
+        end
+
+        GPIO_EN_SET_OFFSET: begin
+          reg_d.en = new_reg.en | (bit_mask & obi_wdata[GpioCount-1:0]);
+        end
+
+        GPIO_EN_CLR_OFFSET: begin
+          reg_d.en = new_reg.en & ~(bit_mask & obi_wdata[GpioCount-1:0]);
+        end
+
+        GPIO_OUT_SET_OFFSET: begin
+          reg_d.out = new_reg.out | (bit_mask & obi_wdata[GpioCount-1:0]);
+        end
+
+        GPIO_OUT_CLR_OFFSET: begin
+          reg_d.out = new_reg.out & ~(bit_mask & obi_wdata[GpioCount-1:0]);
+        end
+
+        GPIO_INTRPT_EN_SET_OFFSET: begin
+          reg_d.intrpt_en = new_reg.intrpt_en | (bit_mask & obi_wdata[GpioCount-1:0]);
+        end
+
+        GPIO_INTRPT_EN_CLR_OFFSET: begin
+          reg_d.intrpt_en = new_reg.intrpt_en & ~(bit_mask & obi_wdata[GpioCount-1:0]);
+        end
+
+        GPIO_WAVE_CFG_OFFSET: begin
+          wave_period_d = obi_wdata[15:0];
+          wave_enable_d = obi_wdata[16];
+        end
+
+        GPIO_WAVE_MASK_OFFSET: begin
+          wave_mask_d = (~bit_mask & wave_mask_q) | (bit_mask & obi_wdata);
+        end
+
+        GPIO_WAVE_DATA_OFFSET: begin
+          wave_push = 1'b1; // dropped by the engine if its FIFO is full
+        end
+
         default: begin
           w_err_d = 1'b1; // unmapped register access
         end
@@ -237,6 +305,38 @@ module gpio_reg_top import gpio_reg_pkg::*; #(
           obi_rdata = reg_q.intrpt_edge;
         end
 
+        GPIO_DIR_SET_OFFSET, GPIO_DIR_CLR_OFFSET: begin
+          obi_rdata = reg_q.dir;
+        end
+
+        GPIO_EN_SET_OFFSET, GPIO_EN_CLR_OFFSET: begin
+          obi_rdata = reg_q.en;
+        end
+
+        GPIO_OUT_SET_OFFSET, GPIO_OUT_CLR_OFFSET: begin
+          obi_rdata = reg_q.out;
+        end
+
+        GPIO_INTRPT_EN_SET_OFFSET, GPIO_INTRPT_EN_CLR_OFFSET: begin
+          obi_rdata = reg_q.intrpt_en;
+        end
+
+        GPIO_WAVE_CFG_OFFSET: begin
+          obi_rdata = {15'h0, wave_enable_q, wave_period_q};
+        end
+
+        GPIO_WAVE_MASK_OFFSET: begin
+          obi_rdata = wave_mask_q;
+        end
+
+        GPIO_WAVE_DATA_OFFSET: begin
+          obi_rdata = '0;
+        end
+
+        GPIO_WAVE_STATUS_OFFSET: begin
+          obi_rdata = {14'h0, wave_hw2reg.full, wave_hw2reg.empty, wave_hw2reg.level};
+        end
+
         default: begin
           obi_rdata = 32'hBADCAB1E;  // Return error value in devmode for unmapped reads
           obi_err   = 1'b1;
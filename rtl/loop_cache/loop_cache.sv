@@ -0,0 +1,193 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+`include "common_cells/registers.svh"
+
+// Loop cache between the core instruction port and the main crossbar
+//
+// A small direct-mapped cache of single-word lines for instruction fetches from the cacheable
+// region (the SRAM). A hit is granted right away and answered in the next cycle without a
+// crossbar request, so a loop that fits into the cache runs from it and leaves the SRAM banks
+// to the data port. Misses and fetches outside of the region are forwarded unchanged, the
+// returned words of cacheable misses are filled in.
+//
+// Accepted writes of the snooped managers (core data port, debug module, user domain)
+// invalidate the line of their address and a fetched fence.i invalidates the whole cache.
+// Snooping does not cover a miss already in flight nor the core's prefetch buffer, so as on
+// any RISC-V core software must execute fence.i after writing code and before running it.
+//
+// Responses are returned in request order: a hit is only accepted once no forwarded request
+// is outstanding anymore.
+module loop_cache #(
+  /// The request struct of the instruction and snooped ports.
+  parameter type         obi_req_t   = logic,
+  /// The response struct of the instruction and snooped ports.
+  parameter type         obi_rsp_t   = logic,
+  /// Number of cached words (power of two), 0 disables the cache (pass-through)
+  parameter int unsigned NumWords    = 16,
+  /// Number of snooped manager ports
+  parameter int unsigned NumSnoop    = 1,
+  /// Cacheable region, aligned to its size (power of two)
+  parameter logic [31:0] CacheBase   = 32'h1000_0000,
+  parameter int unsigned CacheSize   = 32'h1000
+) (
+  input  logic clk_i,
+  input  logic rst_ni,
+
+  /// Instruction port from the core
+  input  obi_req_t core_req_i,
+  output obi_rsp_t core_rsp_o,
+  /// Instruction port towards the crossbar
+  output obi_req_t mem_req_o,
+  input  obi_rsp_t mem_rsp_i,
+
+  /// Snooped manager ports (observed only)
+  input  obi_req_t [NumSnoop-1:0] snoop_req_i,
+  input  obi_rsp_t [NumSnoop-1:0] snoop_rsp_i,
+
+  /// Accepted cache hit (one cycle pulse per fetch)
+  output logic hit_o,
+  /// Accepted cacheable miss (one cycle pulse per fetch)
+  output logic miss_o
+);
+
+  if (NumWords == 0) begin : gen_bypass
+    assign mem_req_o  = core_req_i;
+    assign core_rsp_o = mem_rsp_i;
+    assign hit_o      = 1'b0;
+    assign miss_o     = 1'b0;
+
+  end else begin : gen_cache
+    localparam int unsigned IdxWidth      = $clog2(NumWords);
+    localparam int unsigned RegionWidth   = $clog2(CacheSize);
+    localparam int unsigned TagWidth      = RegionWidth - 2 - IdxWidth;
+    localparam int unsigned MaxOutstanding = 2; // matches NumMaxTrans of the main xbar
+
+    typedef logic [IdxWidth-1:0] idx_t;
+    typedef logic [TagWidth-1:0] tag_t;
+
+    // forwarded requests waiting for their response
+    typedef struct packed {
+      logic fill; // cacheable and still valid to fill in (no write or flush since)
+      idx_t idx;
+      tag_t tag;
+    } pending_t;
+
+    function automatic logic cacheable(logic [31:0] addr);
+      return addr[31:RegionWidth] == CacheBase[31:RegionWidth];
+    endfunction
+
+    function automatic logic is_fence_i(logic [31:0] instr);
+      return (instr[6:0] == 7'b0001111) && (instr[14:12] == 3'b001); // MISC-MEM, funct3 FENCE.I
+    endfunction
+
+    logic [NumWords-1:0] valid_d, valid_q;
+    tag_t [NumWords-1:0] tags_d, tags_q;
+    logic [NumWords-1:0][31:0] data_d, data_q;
+
+    pending_t [MaxOutstanding-1:0] pending_d, pending_q;
+    logic wr_ptr_d, wr_ptr_q, rd_ptr_d, rd_ptr_q;
+    logic [1:0] num_pending_d, num_pending_q;
+
+    // a forwarded request is kept until granted even if a fill turns it into a hit
+    logic forwarding_d, forwarding_q;
+
+    // registered hit response
+    logic hit_rsp_d, hit_rsp_q;
+    logic [31:0] hit_data_d, hit_data_q;
+    logic [$bits(core_req_i.a.aid)-1:0] hit_id_d, hit_id_q;
+
+    `FF(valid_q,       valid_d,       '0, clk_i, rst_ni)
+    `FFNR(tags_q,      tags_d,            clk_i)
+    `FFNR(data_q,      data_d,            clk_i)
+    `FF(pending_q,     pending_d,     '0, clk_i, rst_ni)
+    `FF(wr_ptr_q,      wr_ptr_d,      '0, clk_i, rst_ni)
+    `FF(rd_ptr_q,      rd_ptr_d,      '0, clk_i, rst_ni)
+    `FF(num_pending_q, num_pending_d, '0, clk_i, rst_ni)
+    `FF(forwarding_q,  forwarding_d,  '0, clk_i, rst_ni)
+    `FF(hit_rsp_q,     hit_rsp_d,     '0, clk_i, rst_ni)
+    `FF(hit_data_q,    hit_data_d,    '0, clk_i, rst_ni)
+    `FF(hit_id_q,      hit_id_d,      '0, clk_i, rst_ni)
+
+    idx_t req_idx;
+    tag_t req_tag;
+    logic req_cacheable, req_hit, can_hit, flush;
+    assign req_idx       = core_req_i.a.addr[2+:IdxWidth];
+    assign req_tag       = core_req_i.a.addr[2+IdxWidth+:TagWidth];
+    assign req_cacheable = cacheable(core_req_i.a.addr);
+    assign req_hit       = req_cacheable && valid_q[req_idx] && (tags_q[req_idx] == req_tag) &&
+                           !forwarding_q;
+    // all earlier forwarded requests are answered by the end of this cycle
+    assign can_hit       = (num_pending_q == 2'(mem_rsp_i.rvalid));
+
+    always_comb begin
+      mem_req_o         = core_req_i;
+      mem_req_o.req     = core_req_i.req && !req_hit;
+
+      core_rsp_o        = mem_rsp_i;
+      core_rsp_o.gnt    = req_hit ? can_hit : mem_rsp_i.gnt;
+      if (hit_rsp_q) begin
+        core_rsp_o.rvalid  = 1'b1;
+        core_rsp_o.r.rdata = hit_data_q;
+        core_rsp_o.r.err   = 1'b0;
+        core_rsp_o.r.rid   = hit_id_q;
+      end
+    end
+
+    assign hit_o  = core_req_i.req && req_hit && can_hit;
+    assign miss_o = mem_req_o.req && mem_rsp_i.gnt && req_cacheable;
+
+    assign forwarding_d = mem_req_o.req && !mem_rsp_i.gnt;
+    assign hit_rsp_d    = hit_o;
+    assign hit_data_d   = hit_o ? data_q[req_idx] : hit_data_q;
+    assign hit_id_d     = hit_o ? core_req_i.a.aid : hit_id_q;
+
+    // fence.i passing to the core
+    assign flush = core_rsp_o.rvalid && is_fence_i(core_rsp_o.r.rdata);
+
+    always_comb begin
+      valid_d       = valid_q;
+      tags_d        = tags_q;
+      data_d        = data_q;
+      pending_d     = pending_q;
+      wr_ptr_d      = wr_ptr_q;
+      rd_ptr_d      = rd_ptr_q;
+      num_pending_d = num_pending_q;
+
+      // response of the oldest forwarded request, fill it in
+      if (mem_rsp_i.rvalid && num_pending_q != '0) begin
+        if (pending_q[rd_ptr_q].fill && !mem_rsp_i.r.err) begin
+          valid_d[pending_q[rd_ptr_q].idx] = 1'b1;
+          tags_d [pending_q[rd_ptr_q].idx] = pending_q[rd_ptr_q].tag;
+          data_d [pending_q[rd_ptr_q].idx] = mem_rsp_i.r.rdata;
+        end
+        rd_ptr_d      = !rd_ptr_q;
+        num_pending_d = num_pending_d - 2'd1;
+      end
+
+      if (mem_req_o.req && mem_rsp_i.gnt) begin
+        pending_d[wr_ptr_q] = '{fill: req_cacheable, idx: req_idx, tag: req_tag};
+        wr_ptr_d      = !wr_ptr_q;
+        num_pending_d = num_pending_d + 2'd1;
+      end
+
+      // writes invalidate their line and any fill still in flight for it
+      for (int unsigned s = 0; s < NumSnoop; s++) begin
+        if (snoop_req_i[s].req && snoop_rsp_i[s].gnt && snoop_req_i[s].a.we &&
+            cacheable(snoop_req_i[s].a.addr)) begin
+          valid_d[snoop_req_i[s].a.addr[2+:IdxWidth]] = 1'b0;
+          for (int unsigned p = 0; p < MaxOutstanding; p++) begin
+            if (pending_d[p].idx == snoop_req_i[s].a.addr[2+:IdxWidth]) pending_d[p].fill = 1'b0;
+          end
+        end
+      end
+
+      if (flush) begin
+        valid_d = '0;
+        for (int unsigned p = 0; p < MaxOutstanding; p++) pending_d[p].fill = 1'b0;
+      end
+    end
+  end
+
+endmodule
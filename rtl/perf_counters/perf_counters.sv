@@ -0,0 +1,247 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+`include "common_cells/registers.svh"
+
+// Performance counters of the main crossbar
+//
+// Observes the requests of every crossbar manager (before arbitration) and counts per manager:
+// - REQ:  accepted requests (req && gnt)
+// - WAIT: cycles a request waits for its grant (req && !gnt), i.e. contention and busy targets
+// - LAT:  sum of the response latencies (cycles from the grant to rvalid), LAT/REQ is the mean
+// - SBR:  accepted requests per subordinate, in croc_pkg::croc_xbar_outputs_e order
+// and the cycles the counters were enabled, plus a number of single-cycle event inputs (e.g. the
+// hits and misses of the loop cache).
+//
+// The counters only run while enabled. Software reads a snapshot instead of the live counters,
+// so all values belong to the same cycle: write CTRL.snapshot, then read the counters.
+// Writing snapshot and clear together captures the counters and restarts them from zero.
+//
+// Register map (byte offsets):
+// 0x000 CTRL   (RW) [0] enable (set by every write); write only, read as 0: [1] clear, [2] snapshot
+// 0x004 CYCLES (R)  enabled cycles
+// 0x008 INFO   (R)  [7:0] number of managers, [15:8] number of subordinates, [23:16] events
+// 0x040 + 4*e       EVENT e, cycles the event input was set
+// 0x100 + 0x40*m    counters of manager m (croc_pkg::croc_xbar_managers_e)
+//       +0x00 REQ, +0x04 WAIT, +0x08 LAT, +0x10 + 4*s SBR of subordinate s
+module perf_counters #(
+  /// The OBI configuration of the register port.
+  parameter obi_pkg::obi_cfg_t ObiCfg       = obi_pkg::ObiDefaultConfig,
+  /// The register port request struct.
+  parameter type               obi_req_t    = logic,
+  /// The register port response struct.
+  parameter type               obi_rsp_t    = logic,
+  /// The request struct of the observed managers.
+  parameter type               mgr_req_t    = logic,
+  /// The response struct of the observed managers.
+  parameter type               mgr_rsp_t    = logic,
+  /// Number of observed managers
+  parameter int unsigned       NumMgr       = 4,
+  /// Number of crossbar subordinates (including the error subordinate at index 0)
+  parameter int unsigned       NumSbr       = 5,
+  /// Number of crossbar address rules
+  parameter int unsigned       NumRules     = 4,
+  /// Crossbar address rule type
+  parameter type               addr_rule_t  = logic,
+  /// Crossbar address map, unmapped addresses count towards subordinate 0
+  parameter addr_rule_t [NumRules-1:0] AddrMap = '0,
+  /// Number of event inputs (at most 16)
+  parameter int unsigned       NumEvents    = 1,
+  /// Counter width
+  parameter int unsigned       CntWidth     = 32
+) (
+  input  logic clk_i,
+  input  logic rst_ni,
+
+  /// Observed manager requests
+  input  mgr_req_t [NumMgr-1:0] mgr_req_i,
+  /// Observed manager responses
+  input  mgr_rsp_t [NumMgr-1:0] mgr_rsp_i,
+  /// Counted events
+  input  logic [NumEvents-1:0] event_i,
+
+  /// OBI request interface
+  input  obi_req_t obi_req_i,
+  /// OBI response interface
+  output obi_rsp_t obi_rsp_o
+);
+
+  // Register offsets (word addresses within the 4KB region)
+  localparam logic [9:0] CtrlAddr   = 10'h000;
+  localparam logic [9:0] CyclesAddr = 10'h001;
+  localparam logic [9:0] InfoAddr   = 10'h002;
+  localparam logic [9:0] EventAddr  = 10'h010;
+  localparam logic [9:0] MgrAddr    = 10'h040;
+  localparam int unsigned MgrWords  = 16;
+
+  // counters per manager: REQ, WAIT, LAT, one unused slot, then SBR
+  localparam int unsigned CntReq  = 0;
+  localparam int unsigned CntWait = 1;
+  localparam int unsigned CntLat  = 2;
+  localparam int unsigned CntSbr  = 4;
+  localparam int unsigned NumCnt  = CntSbr + NumSbr;
+
+  localparam int unsigned SbrIdxWidth = cf_math_pkg::idx_width(NumSbr);
+  localparam int unsigned MgrIdxWidth = cf_math_pkg::idx_width(NumMgr);
+
+  typedef logic [CntWidth-1:0] cnt_t;
+
+  if (NumCnt > MgrWords) begin : gen_too_many_sbr
+    $fatal(1, "perf_counters: at most %0d subordinates", MgrWords - CntSbr);
+  end
+
+  //-----------------------------------------------------------------------------------------------
+  // Counters
+  //-----------------------------------------------------------------------------------------------
+
+  logic enable_d, enable_q;
+  logic clear, snapshot;
+
+  cnt_t [NumMgr-1:0][NumCnt-1:0] cnt_d, cnt_q;
+  cnt_t [NumMgr-1:0][NumCnt-1:0] snap_d, snap_q;
+  cnt_t cycles_d, cycles_q;
+  cnt_t cycles_snap_d, cycles_snap_q;
+  cnt_t [NumEvents-1:0] events_d, events_q;
+  cnt_t [NumEvents-1:0] events_snap_d, events_snap_q;
+  logic [NumMgr-1:0][1:0] outstanding_d, outstanding_q; // xbar allows two per manager
+
+  `FF(enable_q,      enable_d,      '0, clk_i, rst_ni)
+  `FF(cnt_q,         cnt_d,         '0, clk_i, rst_ni)
+  `FF(snap_q,        snap_d,        '0, clk_i, rst_ni)
+  `FF(cycles_q,      cycles_d,      '0, clk_i, rst_ni)
+  `FF(cycles_snap_q, cycles_snap_d, '0, clk_i, rst_ni)
+  `FF(events_q,      events_d,      '0, clk_i, rst_ni)
+  `FF(events_snap_q, events_snap_d, '0, clk_i, rst_ni)
+  `FF(outstanding_q, outstanding_d, '0, clk_i, rst_ni)
+
+  // target subordinate of every manager request
+  logic [NumMgr-1:0][SbrIdxWidth-1:0] sbr_idx;
+
+  for (genvar m = 0; m < NumMgr; m++) begin : gen_decode
+    addr_decode #(
+      .NoIndices ( NumSbr            ),
+      .NoRules   ( NumRules          ),
+      .addr_t    ( logic [31:0]      ),
+      .rule_t    ( addr_rule_t       ),
+      .Napot     ( 1'b0              )
+    ) i_addr_decode (
+      .addr_i           ( mgr_req_i[m].a.addr ),
+      .addr_map_i       ( AddrMap             ),
+      .idx_o            ( sbr_idx[m]          ),
+      .dec_valid_o      (),
+      .dec_error_o      (),
+      .en_default_idx_i ( 1'b1                ),
+      .default_idx_i    ( '0                  )
+    );
+  end
+
+  always_comb begin
+    cnt_d         = cnt_q;
+    cycles_d      = cycles_q;
+    events_d      = events_q;
+    outstanding_d = outstanding_q;
+
+    for (int unsigned m = 0; m < NumMgr; m++) begin
+      // transactions are tracked even while disabled, LAT only counts them while enabled
+      if (mgr_req_i[m].req && mgr_rsp_i[m].gnt) outstanding_d[m] = outstanding_d[m] + 2'd1;
+      if (mgr_rsp_i[m].rvalid)                  outstanding_d[m] = outstanding_d[m] - 2'd1;
+    end
+
+    if (enable_q) begin
+      cycles_d = cycles_q + cnt_t'(1);
+      for (int unsigned e = 0; e < NumEvents; e++) begin
+        if (event_i[e]) events_d[e] = events_q[e] + cnt_t'(1);
+      end
+      for (int unsigned m = 0; m < NumMgr; m++) begin
+        if (mgr_req_i[m].req && mgr_rsp_i[m].gnt) begin
+          cnt_d[m][CntReq]            = cnt_q[m][CntReq] + cnt_t'(1);
+          cnt_d[m][CntSbr+sbr_idx[m]] = cnt_q[m][CntSbr+sbr_idx[m]] + cnt_t'(1);
+        end
+        if (mgr_req_i[m].req && !mgr_rsp_i[m].gnt) begin
+          cnt_d[m][CntWait] = cnt_q[m][CntWait] + cnt_t'(1);
+        end
+        cnt_d[m][CntLat] = cnt_q[m][CntLat] + cnt_t'(outstanding_q[m]);
+      end
+    end
+
+    if (clear) begin
+      cnt_d    = '0;
+      cycles_d = '0;
+      events_d = '0;
+    end
+  end
+
+  // the snapshot holds the counters of the cycle the snapshot is written in
+  assign snap_d        = snapshot ? cnt_q    : snap_q;
+  assign cycles_snap_d = snapshot ? cycles_q : cycles_snap_q;
+  assign events_snap_d = snapshot ? events_q : events_snap_q;
+
+  //-----------------------------------------------------------------------------------------------
+  // Register interface
+  //-----------------------------------------------------------------------------------------------
+
+  // Registers holding the response, one cycle after the request
+  logic req_q;
+  logic [ObiCfg.IdWidth-1:0] id_q;
+  logic [ObiCfg.DataWidth-1:0] rsp_data_d, rsp_data_q;
+  logic rsp_err_d, rsp_err_q;
+
+  `FF(req_q,      obi_req_i.req,   '0, clk_i, rst_ni)
+  `FF(id_q,       obi_req_i.a.aid, '0, clk_i, rst_ni)
+  `FF(rsp_data_q, rsp_data_d,      '0, clk_i, rst_ni)
+  `FF(rsp_err_q,  rsp_err_d,       '0, clk_i, rst_ni)
+
+  logic [9:0] word_addr;
+  logic [9:0] mgr_offset;
+  logic [MgrIdxWidth-1:0] mgr;
+  logic [3:0] cnt;
+  assign word_addr  = obi_req_i.a.addr[11:2];
+  assign mgr_offset = word_addr - MgrAddr;
+  assign mgr        = mgr_offset[4+:MgrIdxWidth];
+  assign cnt        = mgr_offset[3:0];
+
+  always_comb begin
+    rsp_data_d = '0;
+    rsp_err_d  = 1'b0;
+    enable_d   = enable_q;
+    clear      = 1'b0;
+    snapshot   = 1'b0;
+
+    if (obi_req_i.req) begin
+      if (word_addr == CtrlAddr) begin
+        if (obi_req_i.a.we) begin
+          enable_d = obi_req_i.a.wdata[0];
+          clear    = obi_req_i.a.wdata[1];
+          snapshot = obi_req_i.a.wdata[2];
+        end else begin
+          rsp_data_d = 32'(enable_q);
+        end
+      end else if (word_addr == CyclesAddr) begin
+        rsp_data_d = 32'(cycles_snap_q);
+        rsp_err_d  = obi_req_i.a.we;
+      end else if (word_addr == InfoAddr) begin
+        rsp_data_d = {8'h0, 8'(NumEvents), 8'(NumSbr), 8'(NumMgr)};
+        rsp_err_d  = obi_req_i.a.we;
+      end else if (word_addr >= EventAddr && word_addr < EventAddr + NumEvents) begin
+        rsp_data_d = 32'(events_snap_q[word_addr-EventAddr]);
+        rsp_err_d  = obi_req_i.a.we;
+      end else if (word_addr >= MgrAddr && word_addr < MgrAddr + NumMgr * MgrWords) begin
+        if (cnt < NumCnt) rsp_data_d = 32'(snap_q[mgr][cnt]);
+        rsp_err_d = obi_req_i.a.we;
+      end else begin
+        rsp_err_d = 1'b1;
+      end
+    end
+  end
+
+  // A channel:
+  assign obi_rsp_o.gnt = obi_req_i.req;
+  // R channel:
+  assign obi_rsp_o.rvalid = req_q;
+  assign obi_rsp_o.r.rdata = rsp_data_q;
+  assign obi_rsp_o.r.rid = id_q;
+  assign obi_rsp_o.r.err = rsp_err_q;
+  assign obi_rsp_o.r.r_optional = '0;
+
+endmodule
@@ -17,6 +17,8 @@ module tb_croc_soc #(
     // UART
     parameter int unsigned  UartBaudRate      = 115200,
     parameter int unsigned  UartParityEna     = 0,
+    // divisor the UART boot loader switches to for the download (1: ClkFrequency/16 baud)
+    parameter int unsigned  UartBootDivisor   = 1,
 
     localparam int unsigned ClkFrequency = 1s / ClkPeriod
 )();
@@ -35,6 +37,7 @@ module tb_croc_soc #(
 
     logic fetch_en_i;
     logic status_o;
+    logic bootmode_i;
 
     localparam int unsigned GpioCount = 32;
 
@@ -54,6 +57,8 @@ module tb_croc_soc #(
     //  Command Line Arguments //
     /////////////////////////////
     string binary_path;
+    string bootmode_str;
+    croc_pkg::bootmode_e bootmode = croc_pkg::Jtag;
     initial begin
         if ($value$plusargs("binary=%s", binary_path)) begin
             $display("Running program: %s", binary_path);
@@ -61,6 +66,10 @@ module tb_croc_soc #(
             $display("No binary path provided. Running helloworld.");
             binary_path = "../sw/bin/helloworld.hex";
         end
+        if ($value$plusargs("bootmode=%s", bootmode_str)) begin
+            if (bootmode_str == "uart") bootmode = croc_pkg::Uart;
+            else if (bootmode_str != "jtag") $fatal(1, "Unknown bootmode %s (jtag, uart)", bootmode_str);
+        end
     end
 
 
@@ -98,6 +107,7 @@ module tb_croc_soc #(
     ////////////
     localparam dm::sbcs_t JtagInitSbcs = dm::sbcs_t'{
         sbautoincrement: 1'b1, sbreadondata: 1'b1, sbaccess: 3, default: '0};
+    localparam logic [4:0] DmiAccess = 5'h11; // IR of the DMI access register
 
     riscv_dbg_simple #(
         .IrLength ( 5 ),
@@ -216,72 +226,135 @@ module tb_croc_soc #(
     endtask
 
 
-    // Load the binary formated as 32bit hex file
-    task jtag_load_hex(input string filename);
+    // Read a hex file (objcopy -O verilog, one '@' line per contiguous segment) into the start
+    // address and the little-endian words of every segment
+    typedef bit [31:0] word_queue_t[$];
+
+    task automatic read_hex(
+        input  string       filename,
+        output bit [31:0]   seg_addr[$],
+        output word_queue_t seg_words[$]
+    );
         int file;
-        int status;
         string line;
         bit [31:0] addr;
-        bit [31:0] data;
         bit [7:0] byte_data;
+        bit [31:0] data;
         int byte_count;
-        static dm::sbcs_t sbcs = dm::sbcs_t'{sbautoincrement: 1'b1, sbaccess: 2, default: '0};
 
         file = $fopen(filename, "r");
-        if (file == 0) begin
-            if (file == 0) begin
-                $fatal(1, "Error: Failed to open file %s", filename);
-        end
-        end
-
-        $display("@%t | [JTAG] Loading binary from %s", $time, filename);
-        jtag_dbg.write_dmi(dm::SBCS, sbcs);
+        if (file == 0) $fatal(1, "Error: Failed to open file %s", filename);
 
-        // line by line
-        while (!$feof(file)) begin
-            if ($fgets(line, file) == 0) begin
-                break; // End of file
-            end
-            
+        byte_count = 0;
+        while ($fgets(line, file) != 0) begin
             // '@' indicates address
             if (line[0] == "@") begin
-                status = $sscanf(line, "@%h", addr);
-                if (status != 1) begin
+                if ($sscanf(line, "@%h", addr) != 1)
                     $fatal(1, "Error: Incorrect address line format in file %s", filename);
-                end
-                $display("@%t | [JTAG] Writing to memory @%08x ", $time, addr);
-                jtag_dbg.write_dmi(dm::SBAddress0, addr);
+                if (byte_count != 0) seg_words[seg_words.size()-1].push_back(data >> 8*(4-byte_count));
+                seg_addr.push_back(addr);
+                seg_words.push_back({});
+                byte_count = 0;
                 continue;
             end
+            // one byte after the other (2 numbers + 1 space)
+            while ($sscanf(line, "%h", byte_data) == 1) begin
+                data = {byte_data, data[31:8]};
+                byte_count++;
+                if (byte_count == 4) begin
+                    seg_words[seg_words.size()-1].push_back(data);
+                    byte_count = 0;
+                end
+                line = line.substr(3, line.len()-1);
+            end
+        end
+        if (byte_count != 0) seg_words[seg_words.size()-1].push_back(data >> 8*(4-byte_count));
+        $fclose(file);
+    endtask
 
-            byte_count = 0;
-            data = 32'h0;
+    // TCK cycles, for the load statistics
+    longint unsigned jtag_tck_cycles = 0;
+    always @(posedge jtag_tck_i) jtag_tck_cycles++;
+
+    // Write consecutive words over the system bus access of the debug module.
+    // SBCS is set up for auto-increment once, then the SBData0 writes are shifted back to back
+    // (from Update-DR directly to the next scan, without Run-Test/Idle) without any polling.
+    // Only the end of the block checks for DMI writes the DTM dropped as too fast (dmistat) and
+    // for system bus errors (SBCS). idle_cycles adds Run-Test/Idle cycles after every word.
+    task automatic jtag_burst_write(
+        input  logic [31:0] addr,
+        input  word_queue_t data,
+        output bit          ok,
+        input  int unsigned idle_cycles = 0
+    );
+        localparam int unsigned DmiWidth = $bits(dm::dmi_req_t);
+        automatic dm::sbcs_t sbcs = dm::sbcs_t'{sbautoincrement: 1'b1, sbaccess: 2,
+                                                 sbbusyerror: 1'b1, sberror: '1, default: '0};
+        logic dmi_bits [DmiWidth];
+        logic [DmiWidth-1:0] dmi_packed;
+        dm::dtmcs_t dtmcs;
+
+        jtag_write(dm::SBCS, sbcs); // also clears previous errors
+        jtag_write(dm::SBAddress0, addr);
 
-            // Loop through the line to read bytes
-            while (line.len() > 0) begin
-                status = $sscanf(line, "%h", byte_data); // Extract one byte
-                if (status != 1) begin
-                    break; // No more data to read on this line
-                end
+        jtag_dbg.jtag.set_ir(DmiAccess);
+        jtag_dbg.jtag.shift_dr();
+        foreach (data[i]) begin
+            dmi_packed = {7'(dm::SBData0), data[i], dm::DTM_WRITE};
+            for (int b = 0; b < DmiWidth; b++) dmi_bits[b] = dmi_packed[b];
+            jtag_dbg.jtag.write_bits_dmi(dmi_bits, 1'b1);
+            jtag_dbg.jtag.write_tms(1); // update DR
+            if (i == data.size()-1 || idle_cycles != 0) begin
+                jtag_dbg.jtag.write_tms(0); // run test idle
+                jtag_dbg.wait_idle(idle_cycles);
+                if (i != data.size()-1) jtag_dbg.jtag.shift_dr();
+            end else begin
+                jtag_dbg.jtag.write_tms(1); // select DR scan
+                jtag_dbg.jtag.write_tms(0); // capture DR
+                jtag_dbg.jtag.write_tms(0); // shift DR
+            end
+        end
 
-                // Shift in the byte to the correct position in the data word
-                data = {byte_data, data[31:8]}; // Combine bytes into a 32-bit word
-                byte_count++;
+        // end of block: were all writes accepted and executed?
+        jtag_dbg.wait_idle(10);
+        jtag_dbg.read_dtmcs(dtmcs);
+        jtag_dbg.read_dmi_exp_backoff(dm::SBCS, sbcs);
+        ok = (dtmcs.dmistat == 0) && !sbcs.sbbusyerror && (sbcs.sberror == 0);
+        if (dtmcs.dmistat != 0) jtag_dbg.reset_dmi();
+    endtask
 
-                // remove the byte from the line (2 numbers + 1 space)
-                line = line.substr(3, line.len()-1);
+    // Load the binary formated as 32bit hex file, one burst per segment
+    task automatic jtag_load_hex(input string filename);
+        bit [31:0] seg_addr[$];
+        word_queue_t seg_words[$];
+        longint unsigned tck_start, words;
+        bit ok;
 
-                // write a complete word via jtag
-                if (byte_count == 4) begin
-                    jtag_write(dm::SBData0, data);
-                    addr += 4;
-                    data = 32'h0;
-                    byte_count = 0;
-                end
+        $display("@%t | [JTAG] Loading binary from %s", $time, filename);
+        read_hex(filename, seg_addr, seg_words);
+
+        tck_start = jtag_tck_cycles;
+        words     = 0;
+        foreach (seg_addr[s]) begin
+            int unsigned idle_cycles = 0;
+            $display("@%t | [JTAG] Writing to memory @%08x ", $time, seg_addr[s]);
+            // too fast for the system bus: send the block again, slower
+            for (int attempt = 0; attempt < 8; attempt++) begin
+                jtag_burst_write(seg_addr[s], seg_words[s], ok, idle_cycles);
+                if (ok) break;
+                idle_cycles = (idle_cycles == 0) ? 1 : 2*idle_cycles;
+                $display("@%t | [JTAG] Burst failed, retrying with %0d idle cycles per word",
+                         $time, idle_cycles);
             end
+            if (!ok) $fatal(1, "@%t | [JTAG] Failed to load @%08x", $time, seg_addr[s]);
+            words += seg_words[s].size();
         end
         jtag_dbg.write_dmi(dm::SBCS, JtagInitSbcs);
-        $fclose(file);
+
+        if (words != 0)
+            $display("@%t | [JTAG] Loaded %0d words in %0d TCK cycles (%0d.%02d per word)", $time,
+                     words, jtag_tck_cycles - tck_start, (jtag_tck_cycles - tck_start) / words,
+                     (jtag_tck_cycles - tck_start) * 100 / words % 100);
     endtask
 
     // Wait for termination signal and get return code
@@ -308,6 +381,9 @@ module tb_croc_soc #(
     localparam UartRealBaudRate = ClkFrequency / (UartDivisior*16);
     localparam time UartBaudPeriod = 1s/UartRealBaudRate;
 
+    // changed by the UART boot loader for the download
+    time uart_baud_period = UartBaudPeriod;
+
     initial begin
         $display("ClkFrequency: %dMHz", ClkFrequency/1000_000);
         $display("UartRealBaudRate: %d", UartRealBaudRate);
@@ -331,20 +407,20 @@ module tb_croc_soc #(
         // Start bit
         @(negedge uart_tx_o);
         uart_reading_byte = 1;
-        #(UartBaudPeriod/2);
+        #(uart_baud_period/2);
         // 8-bit byte
         for (int i = 0; i < 8; i++) begin
-        #UartBaudPeriod bite[i] = uart_tx_o;
+        #uart_baud_period bite[i] = uart_tx_o;
         end
         // Parity bit
         if(UartParityEna) begin
         bit parity;
-        #UartBaudPeriod parity = uart_tx_o;
+        #uart_baud_period parity = uart_tx_o;
         if(parity ^ (^bite))
             $error("[UART] - Parity error detected!");
         end
         // Stop bit
-        #UartBaudPeriod;
+        #uart_baud_period;
         uart_reading_byte=0;
     endtask
 
@@ -353,13 +429,74 @@ module tb_croc_soc #(
         uart_rx_i = 1'b0;
         // 8-bit byte
         for (int i = 0; i < 8; i++)
-        #UartBaudPeriod uart_rx_i = bite[i];
+        #uart_baud_period uart_rx_i = bite[i];
         // Parity bit
         if (UartParityEna)
-        #UartBaudPeriod uart_rx_i = (^bite);
+        #uart_baud_period uart_rx_i = (^bite);
         // Stop bit
-        #UartBaudPeriod uart_rx_i = 1'b1;
-        #UartBaudPeriod;
+        #uart_baud_period uart_rx_i = 1'b1;
+        #uart_baud_period;
+    endtask
+
+    // Send a command to the UART boot loader and check its single character answer
+    task automatic uart_boot_cmd(input byte_bt cmd[$], input byte_bt expected);
+        byte_bt answer;
+        fork
+            uart_read_byte(answer);
+            foreach (cmd[i]) uart_write_byte(cmd[i]);
+        join
+        if (answer != expected)
+            $fatal(1, "@%t | [UART] Boot loader answered '%c' instead of '%c'", $time, answer, expected);
+    endtask
+
+    function automatic void uart_push32(ref byte_bt bytes[$], input bit [31:0] word);
+        for (int i = 0; i < 4; i++) bytes.push_back(word[8*i+:8]);
+    endfunction
+
+    // Load the binary formated as 32bit hex file via the UART boot loader (sw/bootrom/bootrom.S)
+    // and start it at the beginning of the SRAM
+    task automatic uart_load_hex(input string filename);
+        byte_bt answer;
+        byte_bt cmd[$];
+        bit [31:0] seg_addr[$];
+        word_queue_t seg_words[$];
+
+        read_hex(filename, seg_addr, seg_words);
+
+        // the loader greets with "BOOT\n" after reset
+        do uart_read_byte(answer);
+        while (answer != "\n");
+        $display("@%t | [UART] Boot loader ready, switching to divisor %0d", $time, UartBootDivisor);
+
+        cmd = {"b"};
+        uart_push32(cmd, UartBootDivisor);
+        uart_boot_cmd(cmd, "K");
+        // the loader switches once its answer is sent
+        #(uart_baud_period);
+        uart_baud_period = 1s / (ClkFrequency / (UartBootDivisor * 16));
+
+        foreach (seg_addr[s]) begin
+            bit [31:0] sum;
+            $display("@%t | [UART] Loading %0d bytes to @%08x", $time, 4*seg_words[s].size(), seg_addr[s]);
+            cmd = {"l"};
+            uart_push32(cmd, seg_addr[s]);
+            uart_push32(cmd, 4*seg_words[s].size());
+            sum = seg_addr[s];
+            sum = {sum[30:0], sum[31]} + 4*seg_words[s].size();
+            foreach (seg_words[s][i]) begin
+                uart_push32(cmd, seg_words[s][i]);
+                sum = {sum[30:0], sum[31]} + seg_words[s][i];
+            end
+            uart_push32(cmd, sum);
+            uart_boot_cmd(cmd, "O");
+        end
+
+        cmd = {"j"};
+        uart_push32(cmd, croc_pkg::SramBaseAddr + 32'h80);
+        uart_boot_cmd(cmd, "J");
+        // the program configures the UART for the default baud rate again
+        uart_baud_period = UartBaudPeriod;
+        $display("@%t | [UART] Jumped to @%08x", $time, croc_pkg::SramBaseAddr + 32'h80);
     endtask
 
     // Continually read characters and print lines
@@ -413,6 +550,7 @@ module tb_croc_soc #(
         .testmode_i    ( 1'b0       ),
         .fetch_en_i    ( fetch_en_i ),
         .status_o      ( status_o   ),
+        .bootmode_i    ( bootmode_i ),
 
         .jtag_tck_i    ( jtag_tck_i   ),
         .jtag_tdi_i    ( jtag_tdi_i   ),
@@ -447,28 +585,38 @@ module tb_croc_soc #(
         // $dumpvars(1,i_croc_soc);
         //endif
 
-        uart_rx_i  = 1'b0;
+        uart_rx_i  = (bootmode == croc_pkg::Uart); // idle line for the boot loader
         fetch_en_i = 1'b0;
+        bootmode_i = bootmode;
         
         // wait for reset
         #ClkPeriod;
 
-        // init jtag
-        jtag_init();
+        if (bootmode == croc_pkg::Uart) begin
+            // the core starts in the boot ROM by itself, load and start the binary via UART
+            uart_load_hex(binary_path);
+            fetch_en_i = 1'b1;
 
-        // write test value to sram
-        jtag_write_reg32(croc_pkg::SramBaseAddr, 32'h1234_5678, 1'b1);
-        // load binary to sram
-        jtag_load_hex(binary_path);
+            // init jtag (only used to wait for the end of code)
+            jtag_init();
+        end else begin
+            // init jtag
+            jtag_init();
 
-        $display("@%t | [CORE] Start fetching instructions", $time);
-        fetch_en_i = 1'b1;
+            // write test value to sram
+            jtag_write_reg32(croc_pkg::SramBaseAddr, 32'h1234_5678, 1'b1);
+            // load binary to sram
+            jtag_load_hex(binary_path);
 
-        // halt core
-        jtag_halt();
+            $display("@%t | [CORE] Start fetching instructions", $time);
+            fetch_en_i = 1'b1;
 
-        // resume core
-        jtag_resume();
+            // halt core
+            jtag_halt();
+
+            // resume core
+            jtag_resume();
+        end
 
         // wait for non-zero return value (written into core status register)
         $display("@%t | [CORE] Wait for end of code...", $time);
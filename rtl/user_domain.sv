@@ -23,15 +23,24 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
   output logic [NumExternalIrqs-1:0] interrupts_o // interrupts to core
 );
 
-  assign interrupts_o = '0;  
+  logic dma_irq;
+
+  always_comb begin
+    interrupts_o    = '0;
+    interrupts_o[0] = dma_irq;
+  end
 
 
   //////////////////////
   // User Manager MUX //
   /////////////////////
 
-  // No manager so we don't need a obi_mux module and just terminate the request properly
-  assign user_mgr_obi_req_o = '0;
+  // The DMA engine is the only manager so we don't need a obi_mux module and connect it directly
+  mgr_obi_req_t user_dma_mgr_obi_req;
+  mgr_obi_rsp_t user_dma_mgr_obi_rsp;
+
+  assign user_mgr_obi_req_o   = user_dma_mgr_obi_req;
+  assign user_dma_mgr_obi_rsp = user_mgr_obi_rsp_i;
 
 
   ////////////////////////////
@@ -55,9 +64,17 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
   sbr_obi_req_t user_error_obi_req;
   sbr_obi_rsp_t user_error_obi_rsp;
 
-  // BitAcc Subordinate Bus 
-  sbr_obi_req_t user_bit_acc_obi_req; 
-  sbr_obi_rsp_t user_bit_acc_obi_rsp;
+  // Edge Detection Subordinate Bus
+  sbr_obi_req_t user_edge_detect_obi_req;
+  sbr_obi_rsp_t user_edge_detect_obi_rsp;
+
+  // DMA Register Subordinate Bus
+  sbr_obi_req_t user_dma_obi_req;
+  sbr_obi_rsp_t user_dma_obi_rsp;
+
+  // MAC Unit Subordinate Bus
+  sbr_obi_req_t user_mac_obi_req;
+  sbr_obi_rsp_t user_mac_obi_rsp;
 
   // Fanout into more readable signals
   // TODO 3: add the connections with your user_setbitacc signals
@@ -66,8 +83,12 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
   assign user_rom_obi_req                = all_user_sbr_obi_req[UserRom];
   assign all_user_sbr_obi_rsp[UserRom]   = user_rom_obi_rsp;
 
-  assign user_bit_acc_obi_req             = all_user_sbr_obi_req[UserEdgeDetect]; 
-  assign all_user_sbr_obi_rsp[UserEdgeDetect] = user_error_obi_rsp;
+  assign user_edge_detect_obi_req              = all_user_sbr_obi_req[UserEdgeDetect];
+  assign all_user_sbr_obi_rsp[UserEdgeDetect]  = user_edge_detect_obi_rsp;
+  assign user_dma_obi_req                      = all_user_sbr_obi_req[UserDma];
+  assign all_user_sbr_obi_rsp[UserDma]         = user_dma_obi_rsp;
+  assign user_mac_obi_req                      = all_user_sbr_obi_req[UserMac];
+  assign all_user_sbr_obi_rsp[UserMac]         = user_mac_obi_rsp;
 
   //-----------------------------------------------------------------------------------------------
   // Demultiplex to User Subordinates according to address map
@@ -143,17 +164,67 @@ module user_domain import user_pkg::*; import croc_pkg::*; #(
   );
 
   // TODO 4: instanciate user_edge_detect
-  // User SetBitAcc 
-  user_edge_detect #( 
-    .ObiCfg      ( SbrObiCfg ), 
-    .obi_req_t   ( sbr_obi_req_t ), 
-    .obi_rsp_t   ( sbr_obi_rsp_t )  
-  ) i_user_edge_detect ( 
-    .clk_i, 
-    .rst_ni, 
-    .obi_req_i  ( user_bit_acc_obi_req ), 
-    .obi_rsp_o  ( user_bit_acc_obi_rsp ) 
+  // User Edge Detection (Sobel accelerator and set-bit accumulator)
+  user_edge_detect #(
+    .ObiCfg      ( SbrObiCfg     ),
+    .obi_req_t   ( sbr_obi_req_t ),
+    .obi_rsp_t   ( sbr_obi_rsp_t ),
+    .MaxWidth    ( 64            )
+  ) i_user_edge_detect (
+    .clk_i,
+    .rst_ni,
+    .obi_req_i  ( user_edge_detect_obi_req ),
+    .obi_rsp_o  ( user_edge_detect_obi_rsp )
   );
 
+  // DMA engine (register subordinate and user domain manager)
+  user_dma #(
+    .SbrObiCfg     ( SbrObiCfg          ),
+    .sbr_obi_req_t ( sbr_obi_req_t      ),
+    .sbr_obi_rsp_t ( sbr_obi_rsp_t      ),
+    .MgrObiCfg     ( MgrObiCfg          ),
+    .mgr_obi_req_t ( mgr_obi_req_t      ),
+    .mgr_obi_rsp_t ( mgr_obi_rsp_t      ),
+    .NumMaxTrans   ( UserDmaNumMaxTrans )
+  ) i_user_dma (
+    .clk_i,
+    .rst_ni,
+    .testmode_i,
+    .sbr_obi_req_i ( user_dma_obi_req     ),
+    .sbr_obi_rsp_o ( user_dma_obi_rsp     ),
+    .mgr_obi_req_o ( user_dma_mgr_obi_req ),
+    .mgr_obi_rsp_i ( user_dma_mgr_obi_rsp ),
+    .irq_o         ( dma_irq              )
+  );
+
+  // Multiply-accumulate / dot-product unit
+  if (UserMacCoefWords > 0) begin : gen_user_mac
+    user_mac #(
+      .ObiCfg      ( SbrObiCfg        ),
+      .obi_req_t   ( sbr_obi_req_t    ),
+      .obi_rsp_t   ( sbr_obi_rsp_t    ),
+      .CoefWords   ( UserMacCoefWords )
+    ) i_user_mac (
+      .clk_i,
+      .rst_ni,
+      .obi_req_i  ( user_mac_obi_req ),
+      .obi_rsp_o  ( user_mac_obi_rsp )
+    );
+  end else begin : gen_no_user_mac
+    obi_err_sbr #(
+      .ObiCfg      ( SbrObiCfg     ),
+      .obi_req_t   ( sbr_obi_req_t ),
+      .obi_rsp_t   ( sbr_obi_rsp_t ),
+      .NumMaxTrans ( 1             ),
+      .RspData     ( 32'hBADCAB1E  )
+    ) i_user_mac_err (
+      .clk_i,
+      .rst_ni,
+      .testmode_i ( testmode_i       ),
+      .obi_req_i  ( user_mac_obi_req ),
+      .obi_rsp_o  ( user_mac_obi_rsp )
+    );
+  end
+
 
 endmodule
\ No newline at end of file
@@ -0,0 +1,317 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+// gives us the `FF(...) macro making it easy to have properly defined flip-flops
+`include "common_cells/registers.svh"
+
+// Register-programmed DMA engine
+//
+// Copies LEN 32-bit words from SRC to DST through the OBI manager port. After every word the
+// source and destination address advance by their stride, a stride of zero keeps accessing the
+// same address (e.g. a peripheral data register), a negative stride copies backwards.
+// Up to NumMaxTrans requests are in flight at once. Reads are only issued if the data queue has
+// room for their response, writes of already read data always take precedence.
+//
+// Register map (byte offsets):
+// 0x00 SRC        (RW) source start address
+// 0x04 DST        (RW) destination start address
+// 0x08 LEN        (RW) number of words to copy
+// 0x0C SRC_STRIDE (RW) byte increment of the source address (reset: 4)
+// 0x10 DST_STRIDE (RW) byte increment of the destination address (reset: 4)
+// 0x14 CTRL       (RW) [0] start (write-only, ignored while busy), [1] completion irq enable
+// 0x18 STATUS     (R)  [0] busy, [1] done, [2] error (an access returned err)
+//                 (W)  writing 1 to done/error clears them (also cleared by a start)
+module user_dma #(
+  /// The OBI configuration of the register (subordinate) port.
+  parameter obi_pkg::obi_cfg_t SbrObiCfg     = obi_pkg::ObiDefaultConfig,
+  /// The register port request struct.
+  parameter type               sbr_obi_req_t = logic,
+  /// The register port response struct.
+  parameter type               sbr_obi_rsp_t = logic,
+  /// The OBI configuration of the data (manager) port.
+  parameter obi_pkg::obi_cfg_t MgrObiCfg     = obi_pkg::ObiDefaultConfig,
+  /// The data port request struct.
+  parameter type               mgr_obi_req_t = logic,
+  /// The data port response struct.
+  parameter type               mgr_obi_rsp_t = logic,
+  /// Maximum number of outstanding requests on the manager port
+  parameter int unsigned       NumMaxTrans   = 4
+) (
+  /// Clock
+  input  logic clk_i,
+  /// Active-low reset
+  input  logic rst_ni,
+  /// Testmode (bypasses clock gating in the queues)
+  input  logic testmode_i,
+
+  /// OBI register interface
+  input  sbr_obi_req_t sbr_obi_req_i,
+  output sbr_obi_rsp_t sbr_obi_rsp_o,
+
+  /// OBI data interface
+  output mgr_obi_req_t mgr_obi_req_o,
+  input  mgr_obi_rsp_t mgr_obi_rsp_i,
+
+  /// Completion interrupt (level, until done is cleared)
+  output logic irq_o
+);
+
+  // Register offsets (word addresses within the 4KB region)
+  localparam logic [9:0] SrcAddr       = 10'h000;
+  localparam logic [9:0] DstAddr       = 10'h001;
+  localparam logic [9:0] LenAddr       = 10'h002;
+  localparam logic [9:0] SrcStrideAddr = 10'h003;
+  localparam logic [9:0] DstStrideAddr = 10'h004;
+  localparam logic [9:0] CtrlAddr      = 10'h005;
+  localparam logic [9:0] StatusAddr    = 10'h006;
+
+  localparam int unsigned CreditWidth = cf_math_pkg::idx_width(NumMaxTrans+1);
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+  // Register interface //
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  // Signals for the OBI response (one cycle after the request)
+  logic                          valid_d, valid_q;
+  logic [SbrObiCfg.IdWidth-1:0]  id_d, id_q;
+  logic [SbrObiCfg.DataWidth-1:0] rdata_d, rdata_q;
+  logic                          err_d, err_q;
+
+  `FF(valid_q, valid_d, '0, clk_i, rst_ni)
+  `FF(id_q, id_d, '0, clk_i, rst_ni)
+  `FF(rdata_q, rdata_d, '0, clk_i, rst_ni)
+  `FF(err_q, err_d, '0, clk_i, rst_ni)
+
+  assign valid_d = sbr_obi_req_i.req;
+  assign id_d    = sbr_obi_req_i.a.aid;
+
+  always_comb begin
+    sbr_obi_rsp_o         = '0;
+    sbr_obi_rsp_o.gnt     = sbr_obi_req_i.req;
+    sbr_obi_rsp_o.rvalid  = valid_q;
+    sbr_obi_rsp_o.r.rdata = rdata_q;
+    sbr_obi_rsp_o.r.rid   = id_q;
+    sbr_obi_rsp_o.r.err   = err_q;
+  end
+
+  // configuration registers
+  logic [31:0] src_d, src_q;
+  logic [31:0] dst_d, dst_q;
+  logic [31:0] len_d, len_q;
+  logic [31:0] src_stride_d, src_stride_q;
+  logic [31:0] dst_stride_d, dst_stride_q;
+  logic        irq_en_d, irq_en_q;
+  logic        done_d, done_q;
+  logic        error_d, error_q;
+
+  `FF(src_q, src_d, '0, clk_i, rst_ni)
+  `FF(dst_q, dst_d, '0, clk_i, rst_ni)
+  `FF(len_q, len_d, '0, clk_i, rst_ni)
+  `FF(src_stride_q, src_stride_d, 32'd4, clk_i, rst_ni)
+  `FF(dst_stride_q, dst_stride_d, 32'd4, clk_i, rst_ni)
+  `FF(irq_en_q, irq_en_d, '0, clk_i, rst_ni)
+  `FF(done_q, done_d, '0, clk_i, rst_ni)
+  `FF(error_q, error_d, '0, clk_i, rst_ni)
+
+  // transfer state
+  logic [31:0] rd_addr_d, rd_addr_q;  // next address to read
+  logic [31:0] wr_addr_d, wr_addr_q;  // next address to write
+  logic [31:0] rd_left_d, rd_left_q;  // words left to read
+  logic [31:0] wr_left_d, wr_left_q;  // words left to write
+  logic        busy_d, busy_q;
+
+  `FF(rd_addr_q, rd_addr_d, '0, clk_i, rst_ni)
+  `FF(wr_addr_q, wr_addr_d, '0, clk_i, rst_ni)
+  `FF(rd_left_q, rd_left_d, '0, clk_i, rst_ni)
+  `FF(wr_left_q, wr_left_d, '0, clk_i, rst_ni)
+  `FF(busy_q, busy_d, '0, clk_i, rst_ni)
+
+  logic start;          // start request from the register interface
+  logic transfer_done;  // last write response received
+  logic rsp_error;      // manager port response with err set
+
+  logic [9:0] word_addr;
+  assign word_addr = sbr_obi_req_i.a.addr[11:2];
+
+  always_comb begin
+    src_d        = src_q;
+    dst_d        = dst_q;
+    len_d        = len_q;
+    src_stride_d = src_stride_q;
+    dst_stride_d = dst_stride_q;
+    irq_en_d     = irq_en_q;
+    done_d       = done_q | transfer_done;
+    error_d      = error_q | rsp_error;
+    start        = 1'b0;
+    rdata_d      = '0;
+    err_d        = 1'b0;
+
+    if (sbr_obi_req_i.req) begin
+      if (sbr_obi_req_i.a.we) begin
+        case (word_addr)
+          SrcAddr:       src_d        = sbr_obi_req_i.a.wdata;
+          DstAddr:       dst_d        = sbr_obi_req_i.a.wdata;
+          LenAddr:       len_d        = sbr_obi_req_i.a.wdata;
+          SrcStrideAddr: src_stride_d = sbr_obi_req_i.a.wdata;
+          DstStrideAddr: dst_stride_d = sbr_obi_req_i.a.wdata;
+          CtrlAddr: begin
+            irq_en_d = sbr_obi_req_i.a.wdata[1];
+            if (sbr_obi_req_i.a.wdata[0] && !busy_q) begin
+              start   = 1'b1;
+              done_d  = 1'b0;
+              error_d = 1'b0;
+            end
+          end
+          StatusAddr: begin
+            if (sbr_obi_req_i.a.wdata[1]) done_d  = 1'b0;
+            if (sbr_obi_req_i.a.wdata[2]) error_d = 1'b0;
+          end
+          default: err_d = 1'b1;
+        endcase
+      end else begin
+        case (word_addr)
+          SrcAddr:       rdata_d = src_q;
+          DstAddr:       rdata_d = dst_q;
+          LenAddr:       rdata_d = len_q;
+          SrcStrideAddr: rdata_d = src_stride_q;
+          DstStrideAddr: rdata_d = dst_stride_q;
+          CtrlAddr:      rdata_d = {30'h0, irq_en_q, 1'b0};
+          StatusAddr:    rdata_d = {29'h0, error_q, done_q, busy_q};
+          default:       err_d   = 1'b1;
+        endcase
+      end
+    end
+  end
+
+  assign irq_o = done_q & irq_en_q;
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+  // Data mover //
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  // Outstanding requests are tracked in issue order (OBI responses return in order),
+  // each entry records whether the response belongs to a read or a write.
+  logic outst_full, outst_empty, outst_is_read;
+  logic outst_push, outst_pop;
+
+  // Read data waiting to be written
+  logic        data_empty;
+  logic [31:0] data_head;
+  logic        data_push, data_pop;
+
+  // free slots in the data queue that are not reserved by a read in flight
+  logic [CreditWidth-1:0] credit_d, credit_q;
+  `FF(credit_q, credit_d, CreditWidth'(NumMaxTrans), clk_i, rst_ni)
+
+  // a request that did not get its grant must be held stable
+  logic stall_d, stall_q;
+  logic stall_we_d, stall_we_q;
+  `FF(stall_q, stall_d, '0, clk_i, rst_ni)
+  `FF(stall_we_q, stall_we_d, '0, clk_i, rst_ni)
+
+  logic issue_read, issue_write, mgr_gnt;
+
+  always_comb begin
+    issue_write = 1'b0;
+    issue_read  = 1'b0;
+    if (stall_q) begin
+      issue_write =  stall_we_q;
+      issue_read  = ~stall_we_q;
+    end else if (busy_q && !outst_full) begin
+      if (!data_empty && (wr_left_q != '0)) begin
+        issue_write = 1'b1;
+      end else if ((rd_left_q != '0) && (credit_q != '0)) begin
+        issue_read  = 1'b1;
+      end
+    end
+  end
+
+  always_comb begin
+    mgr_obi_req_o         = '0;
+    mgr_obi_req_o.req     = issue_read | issue_write;
+    mgr_obi_req_o.a.we    = issue_write;
+    mgr_obi_req_o.a.addr  = issue_write ? wr_addr_q : rd_addr_q;
+    mgr_obi_req_o.a.be    = '1;
+    mgr_obi_req_o.a.wdata = data_head;
+  end
+
+  assign mgr_gnt    = mgr_obi_req_o.req & mgr_obi_rsp_i.gnt;
+  assign stall_d    = mgr_obi_req_o.req & ~mgr_obi_rsp_i.gnt;
+  assign stall_we_d = issue_write;
+
+  assign outst_push = mgr_gnt;
+  assign outst_pop  = mgr_obi_rsp_i.rvalid;
+  assign data_push  = mgr_obi_rsp_i.rvalid & outst_is_read;
+  assign data_pop   = mgr_gnt & issue_write;
+  assign rsp_error  = mgr_obi_rsp_i.rvalid & mgr_obi_rsp_i.r.err;
+
+  // the final write response completes the transfer
+  assign transfer_done = busy_q && (wr_left_q == '0) && outst_empty;
+
+  always_comb begin
+    rd_addr_d = rd_addr_q;
+    wr_addr_d = wr_addr_q;
+    rd_left_d = rd_left_q;
+    wr_left_d = wr_left_q;
+    busy_d    = busy_q & ~transfer_done;
+    credit_d  = credit_q;
+
+    if (start) begin
+      rd_addr_d = src_q;
+      wr_addr_d = dst_q;
+      rd_left_d = len_q;
+      wr_left_d = len_q;
+      busy_d    = 1'b1;
+    end
+
+    if (mgr_gnt && issue_read) begin
+      rd_addr_d = rd_addr_q + src_stride_q;
+      rd_left_d = rd_left_q - 1;
+      credit_d  = credit_d - 1;
+    end
+
+    if (mgr_gnt && issue_write) begin
+      wr_addr_d = wr_addr_q + dst_stride_q;
+      wr_left_d = wr_left_q - 1;
+      credit_d  = credit_d + 1;
+    end
+  end
+
+  fifo_v3 #(
+    .FALL_THROUGH ( 1'b0        ),
+    .DATA_WIDTH   ( 1           ),
+    .DEPTH        ( NumMaxTrans )
+  ) i_outstanding_fifo (
+    .clk_i,
+    .rst_ni,
+    .flush_i    ( 1'b0          ),
+    .testmode_i ( testmode_i    ),
+    .full_o     ( outst_full    ),
+    .empty_o    ( outst_empty   ),
+    .usage_o    (),
+    .data_i     ( issue_read    ),
+    .push_i     ( outst_push    ),
+    .data_o     ( outst_is_read ),
+    .pop_i      ( outst_pop     )
+  );
+
+  fifo_v3 #(
+    .FALL_THROUGH ( 1'b0        ),
+    .DATA_WIDTH   ( 32          ),
+    .DEPTH        ( NumMaxTrans )
+  ) i_data_fifo (
+    .clk_i,
+    .rst_ni,
+    .flush_i    ( 1'b0                    ),
+    .testmode_i ( testmode_i              ),
+    .full_o     (),
+    .empty_o    ( data_empty              ),
+    .usage_o    (),
+    .data_i     ( mgr_obi_rsp_i.r.rdata   ),
+    .push_i     ( data_push               ),
+    .data_o     ( data_head               ),
+    .pop_i      ( data_pop                )
+  );
+
+endmodule
@@ -5,14 +5,38 @@
 // gives us the `FF(...) macro making it easy to have properly defined flip-flops
 `include "common_cells/registers.svh"
 
-// simple ROM
+// Sobel edge-detection accelerator (plus a set-bit accumulator)
+//
+// Pixels are pushed row by row as packed 4-pixel words (leftmost pixel in the LSB) into
+// three rotating line buffers. Once three rows are buffered, the gradient magnitude
+// |Gx| + |Gy| (saturated to 8 bit) of the middle row can be read back from the output window,
+// one packed 4-pixel word per access. The leftmost and rightmost column are returned as zero.
+//
+// Requests are handled in the request phase and a new one is accepted every cycle. The response
+// is registered once, so reads return one cycle after the grant and responses stay in order.
+//
+// Register map (byte offsets):
+// 0x000 BITACC_CLEAR  (W) clear the set-bit accumulator
+// 0x004 BITACC_ADD    (W) add the number of set bits in wdata to the accumulator
+// 0x008 BITACC_RESULT (R) accumulated number of set bits
+// 0x010 SOBEL_CFG     (RW) [7:0] frame width (multiple of 4, clamped to 4..MaxWidth),
+//                          [23:16] frame height; a write also restarts the frame (clears
+//                          the row/column counters)
+// 0x014 SOBEL_STATUS  (R) [7:0] completed rows, [8] output valid, [9] frame complete
+// 0x018 SOBEL_PIXELS  (W) push the next four pixels of the frame
+// 0x100 SOBEL_OUT     (R) window of MaxWidth/4 words holding the output of the middle row
+// 0x200 BITACC_BULK   (RW) 64-word window, a write to any word adds its set bits to the
+//                          accumulator and a read returns the accumulated total, so a block
+//                          can be accumulated with consecutive stores from one base address
 module user_edge_detect #(
   /// The OBI configuration for all ports.
   parameter obi_pkg::obi_cfg_t           ObiCfg      = obi_pkg::ObiDefaultConfig,
   /// The request struct.
   parameter type                         obi_req_t   = logic,
   /// The response struct.
-  parameter type                         obi_rsp_t   = logic
+  parameter type                         obi_rsp_t   = logic,
+  /// Maximum frame width in pixels (multiple of 4), sets the size of the line buffers
+  parameter int unsigned                 MaxWidth    = 64
 ) (
   /// Clock
   input  logic clk_i,
@@ -25,102 +49,232 @@ module user_edge_detect #(
   output obi_rsp_t obi_rsp_o
 );
 
+  // Register offsets (word addresses within the 4KB region)
+  localparam logic [9:0] BitAccClearAddr  = 10'h000;
+  localparam logic [9:0] BitAccAddAddr    = 10'h001;
+  localparam logic [9:0] BitAccResultAddr = 10'h002;
+  localparam logic [9:0] SobelCfgAddr     = 10'h004;
+  localparam logic [9:0] SobelStatusAddr  = 10'h005;
+  localparam logic [9:0] SobelPixelsAddr  = 10'h006;
+  localparam logic [9:0] SobelOutAddr     = 10'h040;
+  localparam logic [9:0] BitAccBulkAddr   = 10'h080;
+  localparam int unsigned BitAccBulkWords = 64;
 
-  // Define some registers to hold the requests fields
-  logic req_d, req_q, req_q2;
-  logic we_d, we_q, we_q2;
-  logic [ObiCfg.AddrWidth-1:0] addr_d, addr_q, addr_q2;
-  logic [ObiCfg.IdWidth-1:0] id_d, id_q, id_q2;
-  logic [ObiCfg.DataWidth-1:0] wdata_d, wdata_q, wdata_q2;
+  localparam int unsigned LineWords    = MaxWidth / 4; // packed 4-pixel words per line
+  localparam int unsigned NumLines     = 3;            // rows needed for a 3x3 kernel
+  localparam int unsigned ColIdxWidth  = cf_math_pkg::idx_width(LineWords);
+  localparam int unsigned LineIdxWidth = cf_math_pkg::idx_width(NumLines);
+
+  typedef logic [LineWords-1:0][31:0] line_t;
+
+  // Registers holding the response, one cycle after the request
+  logic req_d, req_q;
+  logic [ObiCfg.IdWidth-1:0] id_d, id_q;
 
   // Signals used to create the response
-  logic [ObiCfg.DataWidth-1:0] rsp_data; // Data field of the obi response
-  logic rsp_err; // Error field of the obi response
+  logic [ObiCfg.DataWidth-1:0] rsp_data_d, rsp_data_q; // Data field of the obi response
+  logic rsp_err_d, rsp_err_q; // Error field of the obi response
 
   // Internal signals/registers
-  logic [15:0] set_bits_accumulator_d, set_bits_accumulator_q, set_bits_accumulator_q2; // Holding the accumulated bitcount
-  logic [15:0] wdata_cnt; // Olding the bitcount of the request wdata
-  
-  // Note to avoid writing trivial always_ff statements we can use this macro defined in registers.svh 
+  logic [15:0] set_bits_accumulator_d, set_bits_accumulator_q; // Holding the accumulated bitcount
+  logic [15:0] wdata_cnt; // Holding the bitcount of the request wdata
+
+  // Sobel frame configuration and stream position
+  logic [7:0] width_d, width_q;   // frame width in pixels
+  logic [7:0] height_d, height_q; // frame height in pixels
+  logic [7:0] rows_d, rows_q;     // number of completely received rows
+  logic [ColIdxWidth-1:0]  col_d, col_q;   // next word within the row being received
+  logic [LineIdxWidth-1:0] slot_d, slot_q; // line buffer receiving the current row
+
+  // Line buffers, the row being received overwrites the oldest one
+  line_t [NumLines-1:0] lines_d, lines_q;
+
+  // Note to avoid writing trivial always_ff statements we can use this macro defined in registers.svh
   assign req_d = obi_req_i.req;
-  assign id_d = obi_req_i.a.aid;
-  assign we_d = obi_req_i.a.we;
-  assign addr_d = obi_req_i.a.addr;
-  assign wdata_d = obi_req_i.a.wdata;
-  always_ff @(posedge (clk_i) or negedge (rst_ni)) begin
-    if (!rst_ni) begin
-      req_q <= '0;
-      id_q <= '0;
-      we_q <= '0;
-      addr_q <= '0;
-      wdata_q <= '0;
-      set_bits_accumulator_q <= '0;
-      req_q2 <= '0;
-      id_q2 <= '0;
-      we_q2 <= '0;
-      addr_q2 <= '0;
-      wdata_q2 <= '0;
-      set_bits_accumulator_q2 <= '0;
-    end else begin
-      req_q <= req_d;
-      id_q <= id_d;
-      we_q <= we_d;
-      addr_q <= addr_d;
-      wdata_q <= wdata_d;
-      set_bits_accumulator_q <= set_bits_accumulator_d;
-      req_q2 <= req_q;
-      id_q2 <= id_q;
-      we_q2 <= we_q;
-      addr_q2 <= addr_q;
-      wdata_q2 <= wdata_q;
-      set_bits_accumulator_q2 <= set_bits_accumulator_q;
-    end
+  assign id_d  = obi_req_i.a.aid;
+  `FF(req_q,      req_d,      '0, clk_i, rst_ni)
+  `FF(id_q,       id_d,       '0, clk_i, rst_ni)
+  `FF(rsp_data_q, rsp_data_d, '0, clk_i, rst_ni)
+  `FF(rsp_err_q,  rsp_err_d,  '0, clk_i, rst_ni)
+  `FF(set_bits_accumulator_q, set_bits_accumulator_d, '0, clk_i, rst_ni)
+
+  `FF(width_q,  width_d,  8'(MaxWidth), clk_i, rst_ni)
+  `FF(height_q, height_d, '0, clk_i, rst_ni)
+  `FF(rows_q,   rows_d,   '0, clk_i, rst_ni)
+  `FF(col_q,    col_d,    '0, clk_i, rst_ni)
+  `FF(slot_q,   slot_d,   '0, clk_i, rst_ni)
+  `FF(lines_q,  lines_d,  '0, clk_i, rst_ni)
+
+  // TODO 2: Build wdata_cnt, which counts the number of bits set in the request's data.
+
+  always_comb
+  begin
+    wdata_cnt = 0;
+    for (int i = 0; i < 32 ; i++ )
+      if(obi_req_i.a.wdata[i]) wdata_cnt += 1;
   end
 
-  // TODO 2: Build wdata_cnt, which counts the number of bits set in the previous request's data.
-  
-  always_comb 
-  begin 
-    wdata_cnt = 0; 
-    for (int i = 0; i < 32 ; i++ ) 
-      if(wdata_q2[i]) wdata_cnt += 1;  
+  //-----------------------------------------------------------------------------------------------
+  // Sobel datapath
+  //-----------------------------------------------------------------------------------------------
+
+  // gradient magnitude |Gx| + |Gy| of the center pixel of a 3x3 window, saturated to 8 bit
+  // the window is indexed as win[row][column] with row 0 on top and column 0 on the left
+  function automatic logic [7:0] sobel_magnitude(logic [2:0][2:0][7:0] win);
+    logic [10:0] pos_x, neg_x, pos_y, neg_y;
+    logic [10:0] abs_x, abs_y;
+    logic [11:0] sum;
+    pos_x = win[0][2] + (win[1][2] << 1) + win[2][2];
+    neg_x = win[0][0] + (win[1][0] << 1) + win[2][0];
+    pos_y = win[2][0] + (win[2][1] << 1) + win[2][2];
+    neg_y = win[0][0] + (win[0][1] << 1) + win[0][2];
+    abs_x = (pos_x > neg_x) ? pos_x - neg_x : neg_x - pos_x;
+    abs_y = (pos_y > neg_y) ? pos_y - neg_y : neg_y - pos_y;
+    sum   = abs_x + abs_y;
+    return (sum > 12'd255) ? 8'hFF : sum[7:0];
+  endfunction
+
+  // line buffers holding the rows above, at and below the output row
+  logic [LineIdxWidth-1:0] top_slot, mid_slot, bot_slot;
+  logic [2:0][LineIdxWidth-1:0] row_slots;
+  assign top_slot  = slot_q;
+  assign mid_slot  = (slot_q == LineIdxWidth'(NumLines-1)) ? '0 : slot_q + 1;
+  assign bot_slot  = (slot_q == '0) ? LineIdxWidth'(NumLines-1) : slot_q - 1;
+  assign row_slots = {bot_slot, mid_slot, top_slot};
+
+  // output word requested by the current request
+  logic [ColIdxWidth-1:0] out_col;
+  logic [31:0]            out_word;
+  assign out_col = obi_req_i.a.addr[2+:ColIdxWidth];
+
+  always_comb begin
+    // six pixels per row: last pixel of the previous word, the word itself, first of the next
+    logic [2:0][5:0][7:0] rows;
+    logic [2:0][2:0][7:0] win;
+    logic [7:0]           x;
+
+    for (int unsigned r = 0; r < 3; r++) begin
+      rows[r][4:1] = lines_q[row_slots[r]][out_col];
+      rows[r][0]   = (out_col == '0) ? '0 : lines_q[row_slots[r]][out_col-1][31:24];
+      rows[r][5]   = (out_col == ColIdxWidth'(LineWords-1)) ? '0
+                                                            : lines_q[row_slots[r]][out_col+1][7:0];
+    end
+
+    for (int unsigned j = 0; j < 4; j++) begin
+      for (int unsigned r = 0; r < 3; r++) begin
+        win[r] = rows[r][j+:3];
+      end
+      x = {out_col, 2'(j)};
+      // borders have an incomplete neighbourhood, report no edge
+      if ((x == '0) || (x >= width_q - 8'd1)) begin
+        out_word[8*j+:8] = '0;
+      end else begin
+        out_word[8*j+:8] = sobel_magnitude(win);
+      end
+    end
   end
 
-  // Assign the response data
-  logic [1:0] word_addr;
+  // Handle the request and prepare the response data
+  logic [9:0] word_addr;
+  logic       we;
+  logic [ObiCfg.DataWidth-1:0] wdata;
+  assign word_addr = obi_req_i.a.addr[11:2];
+  assign we        = obi_req_i.a.we;
+  assign wdata     = obi_req_i.a.wdata;
+
   always_comb begin
-    rsp_data = '0;
-    rsp_err  = '0;
-    word_addr = addr_q2[3:2];
-    set_bits_accumulator_d = set_bits_accumulator_q2;
+    rsp_data_d = '0;
+    rsp_err_d  = '0;
+    set_bits_accumulator_d = set_bits_accumulator_q;
+
+    width_d  = width_q;
+    height_d = height_q;
+    rows_d   = rows_q;
+    col_d    = col_q;
+    slot_d   = slot_q;
+    lines_d  = lines_q;
 
     // TODO 1: A write request at address 0x0 will set the accumulator to zero
 
-    if(req_q2) begin
-      case(word_addr)
-        3'h0: begin
-          if(we_q2) begin
-            set_bits_accumulator_d = '0;
-          end else begin
-            rsp_err = '1;
-          end
+    if(obi_req_i.req) begin
+      if (word_addr >= SobelOutAddr && word_addr < SobelOutAddr + LineWords) begin
+        if(we) begin
+          rsp_err_d = '1;
+        end else begin
+          rsp_data_d = out_word;
         end
-        3'h1: begin
-          if(we_q2) begin
-            set_bits_accumulator_d = set_bits_accumulator_q2 + wdata_cnt;
-          end else begin
-            rsp_err = '1;
-          end
+      end else if (word_addr >= BitAccBulkAddr && word_addr < BitAccBulkAddr + BitAccBulkWords) begin
+        if(we) begin
+          set_bits_accumulator_d = set_bits_accumulator_q + wdata_cnt;
+        end else begin
+          rsp_data_d = set_bits_accumulator_q;
         end
-        3'h2: begin
-          if(we_q2) begin
-            rsp_err = '1;
-          end else begin
-            rsp_data = set_bits_accumulator_q2;
+      end else begin
+        case(word_addr)
+          BitAccClearAddr: begin
+            if(we) begin
+              set_bits_accumulator_d = '0;
+            end else begin
+              rsp_err_d = '1;
+            end
           end
-        end
-        default: rsp_data = 32'hffffffff;
-      endcase
+          BitAccAddAddr: begin
+            if(we) begin
+              set_bits_accumulator_d = set_bits_accumulator_q + wdata_cnt;
+            end else begin
+              rsp_err_d = '1;
+            end
+          end
+          BitAccResultAddr: begin
+            if(we) begin
+              rsp_err_d = '1;
+            end else begin
+              rsp_data_d = set_bits_accumulator_q;
+            end
+          end
+          SobelCfgAddr: begin
+            if(we) begin
+              // a row must fit into the line buffers and hold at least one word,
+              // otherwise it would never complete (or underflow width_q - 4)
+              if (wdata[7:0] < 8'd4) begin
+                width_d = 8'd4;
+              end else if (wdata[7:0] > 8'(MaxWidth)) begin
+                width_d = 8'(MaxWidth);
+              end else begin
+                width_d = wdata[7:0];
+              end
+              height_d = wdata[23:16];
+              rows_d   = '0;
+              col_d    = '0;
+              slot_d   = '0;
+            end else begin
+              rsp_data_d = {8'h0, height_q, 8'h0, width_q};
+            end
+          end
+          SobelStatusAddr: begin
+            if(we) begin
+              rsp_err_d = '1;
+            end else begin
+              rsp_data_d = {22'h0, (rows_q == height_q), (rows_q >= 8'd3), rows_q};
+            end
+          end
+          SobelPixelsAddr: begin
+            if(we) begin
+              lines_d[slot_q][col_q] = wdata;
+              col_d = col_q + 1;
+              // last word of the row: continue in the next (oldest) line buffer
+              if ({col_q, 2'b00} >= width_q - 8'd4) begin
+                col_d  = '0;
+                slot_d = mid_slot;
+                rows_d = rows_q + 8'd1;
+              end
+            end else begin
+              rsp_err_d = '1;
+            end
+          end
+          default: rsp_data_d = 32'hffffffff;
+        endcase
+      end
     end
   end
 
@@ -128,10 +282,10 @@ module user_edge_detect #(
   // A channel
   assign obi_rsp_o.gnt = obi_req_i.req;
   // R channel:
-  assign obi_rsp_o.rvalid = req_q2;
-  assign obi_rsp_o.r.rdata = rsp_data;
-  assign obi_rsp_o.r.rid = id_q2;
-  assign obi_rsp_o.r.err = rsp_err;
+  assign obi_rsp_o.rvalid = req_q;
+  assign obi_rsp_o.r.rdata = rsp_data_q;
+  assign obi_rsp_o.r.rid = id_q;
+  assign obi_rsp_o.r.err = rsp_err_q;
   assign obi_rsp_o.r.r_optional = '0;
 
-endmodule
\ No newline at end of file
+endmodule
@@ -0,0 +1,321 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+`include "common_cells/registers.svh"
+
+// Multiply-accumulate / dot-product unit
+//
+// A 32x32 bit multiplier (or two 16x16, or four 8x8 ones on packed operands) and a 64 bit
+// accumulator. The element size of CFG splits every operand word into packed elements (element
+// 0 in the LSBs), a MAC then adds the sum of the element products (the dot product of the two
+// words) to the accumulator. Each operand is signed or unsigned as configured.
+//
+// Vector mode: the coefficients are written to the COEF window once, then every write to the
+// DATA window (consecutive stores from one base address) accumulates the dot product of wdata
+// with the coefficient word at PTR and moves PTR to the next one (wrapping at CoefWords).
+// Writing ACC_LO starts a new dot product: it sets the accumulator and resets PTR.
+//
+// RESULT shifts the accumulator right (arithmetic if an operand is signed) and saturates it.
+// Requests are handled in the request phase and a new one is accepted every cycle, the
+// response is registered once, so reads return one cycle after the grant.
+//
+// Register map (byte offsets):
+// 0x000 A       (RW) scalar operand A
+// 0x004 B       (RW) scalar operand B
+// 0x008 PROD_LO (R)  A * B [31:0] (full 32x32 product, ignores the element size)
+// 0x00C PROD_HI (R)  A * B [63:32]
+// 0x010 CFG     (RW) [0] A signed, [1] B/data signed, [3:2] element size (0: 32, 1: 16, 2: 8 bit),
+//                    [5:4] RESULT saturation (0: none, 1: 32 bit, 2: 16 bit, 3: pixel 0..255),
+//                    [13:8] RESULT shift
+// 0x014 ACC_LO  (RW) accumulator [31:0], a write sets the accumulator (sign-extended if an
+//                    operand is signed) and resets PTR
+// 0x018 ACC_HI  (R)  accumulator [63:32]
+// 0x01C RESULT  (R)  saturate(accumulator >> shift)
+// 0x020 MAC     (W)  B = wdata, accumulator += dot(A, wdata)
+// 0x024 PTR     (RW) coefficient word used by the next DATA write
+// 0x100 COEF    (RW) window of CoefWords coefficient words
+// 0x200 DATA    (RW) 64-word window, a write accumulates dot(COEF[PTR], wdata) and increments
+//                    PTR, a read returns RESULT
+module user_mac #(
+  /// The OBI configuration for all ports.
+  parameter obi_pkg::obi_cfg_t ObiCfg    = obi_pkg::ObiDefaultConfig,
+  /// The request struct.
+  parameter type               obi_req_t = logic,
+  /// The response struct.
+  parameter type               obi_rsp_t = logic,
+  /// Number of coefficient words of the vector mode (at most 64)
+  parameter int unsigned       CoefWords = 16
+) (
+  /// Clock
+  input  logic clk_i,
+  /// Active-low reset
+  input  logic rst_ni,
+
+  /// OBI request interface
+  input  obi_req_t obi_req_i,
+  /// OBI response interface
+  output obi_rsp_t obi_rsp_o
+);
+
+  // Register offsets (word addresses within the 4KB region)
+  localparam logic [9:0] AAddr      = 10'h000;
+  localparam logic [9:0] BAddr      = 10'h001;
+  localparam logic [9:0] ProdLoAddr = 10'h002;
+  localparam logic [9:0] ProdHiAddr = 10'h003;
+  localparam logic [9:0] CfgAddr    = 10'h004;
+  localparam logic [9:0] AccLoAddr  = 10'h005;
+  localparam logic [9:0] AccHiAddr  = 10'h006;
+  localparam logic [9:0] ResultAddr = 10'h007;
+  localparam logic [9:0] MacAddr    = 10'h008;
+  localparam logic [9:0] PtrAddr    = 10'h009;
+  localparam logic [9:0] CoefAddr   = 10'h040;
+  localparam logic [9:0] DataAddr   = 10'h080;
+  localparam int unsigned DataWords = 64;
+
+  localparam int unsigned PtrWidth = cf_math_pkg::idx_width(CoefWords);
+
+  // CFG fields
+  localparam logic [1:0] Elem32   = 2'd0;
+  localparam logic [1:0] Elem16   = 2'd1;
+  localparam logic [1:0] Elem8    = 2'd2;
+  localparam logic [1:0] SatInt32 = 2'd1;
+  localparam logic [1:0] SatInt16 = 2'd2;
+  localparam logic [1:0] SatPixel = 2'd3;
+
+  if (CoefWords > 64) begin : gen_too_many_coefs
+    $fatal(1, "user_mac: at most 64 coefficient words");
+  end
+
+  // Registers holding the response, one cycle after the request
+  logic req_q;
+  logic [ObiCfg.IdWidth-1:0] id_q;
+  logic [ObiCfg.DataWidth-1:0] rsp_data_d, rsp_data_q;
+  logic rsp_err_d, rsp_err_q;
+
+  `FF(req_q,      obi_req_i.req,   '0, clk_i, rst_ni)
+  `FF(id_q,       obi_req_i.a.aid, '0, clk_i, rst_ni)
+  `FF(rsp_data_q, rsp_data_d,      '0, clk_i, rst_ni)
+  `FF(rsp_err_q,  rsp_err_d,       '0, clk_i, rst_ni)
+
+  // Operands, configuration, accumulator and coefficients
+  logic [31:0] a_d, a_q;
+  logic [31:0] b_d, b_q;
+  logic        a_signed_d, a_signed_q;
+  logic        b_signed_d, b_signed_q;
+  logic [1:0]  elem_d, elem_q;
+  logic [1:0]  sat_d, sat_q;
+  logic [5:0]  shift_d, shift_q;
+  logic [63:0] acc_d, acc_q;
+  logic [PtrWidth-1:0] ptr_d, ptr_q;
+  logic [CoefWords-1:0][31:0] coef_d, coef_q;
+
+  `FF(a_q,        a_d,        '0, clk_i, rst_ni)
+  `FF(b_q,        b_d,        '0, clk_i, rst_ni)
+  `FF(a_signed_q, a_signed_d, '0, clk_i, rst_ni)
+  `FF(b_signed_q, b_signed_d, '0, clk_i, rst_ni)
+  `FF(elem_q,     elem_d,     '0, clk_i, rst_ni)
+  `FF(sat_q,      sat_d,      '0, clk_i, rst_ni)
+  `FF(shift_q,    shift_d,    '0, clk_i, rst_ni)
+  `FF(acc_q,      acc_d,      '0, clk_i, rst_ni)
+  `FF(ptr_q,      ptr_d,      '0, clk_i, rst_ni)
+  `FF(coef_q,     coef_d,     '0, clk_i, rst_ni)
+
+  //-----------------------------------------------------------------------------------------------
+  // Datapath
+  //-----------------------------------------------------------------------------------------------
+
+  // sum of the element products of two operand words, elements sign-extended if signed
+  function automatic logic [63:0] dot(logic [31:0] x, logic [31:0] y, logic [1:0] elem,
+                                      logic x_signed, logic y_signed);
+    logic signed [32:0] x32, y32;
+    logic signed [16:0] x16, y16;
+    logic signed [8:0]  x8, y8;
+    logic signed [65:0] prod32;
+    logic signed [33:0] prod16;
+    logic signed [17:0] prod8;
+    logic signed [63:0] sum;
+    sum = '0;
+    unique case (elem)
+      Elem16: begin
+        for (int unsigned i = 0; i < 2; i++) begin
+          x16    = {x_signed & x[16*i+15], x[16*i+:16]};
+          y16    = {y_signed & y[16*i+15], y[16*i+:16]};
+          prod16 = x16 * y16;
+          sum    = sum + 64'(prod16);
+        end
+      end
+      Elem8: begin
+        for (int unsigned i = 0; i < 4; i++) begin
+          x8    = {x_signed & x[8*i+7], x[8*i+:8]};
+          y8    = {y_signed & y[8*i+7], y[8*i+:8]};
+          prod8 = x8 * y8;
+          sum   = sum + 64'(prod8);
+        end
+      end
+      default: begin
+        x32    = {x_signed & x[31], x};
+        y32    = {y_signed & y[31], y};
+        prod32 = x32 * y32;
+        sum    = prod32[63:0];
+      end
+    endcase
+    return sum;
+  endfunction
+
+  // clamps the shifted accumulator to the range of the saturation mode
+  function automatic logic [31:0] saturate(logic signed [64:0] x, logic [1:0] sat,
+                                           logic is_signed);
+    logic signed [64:0] lo, hi;
+    unique case (sat)
+      SatInt32: begin
+        lo = is_signed ? -(65'sd1 <<< 31) : '0;
+        hi = is_signed ?  (65'sd1 <<< 31) - 1 : (65'sd1 <<< 32) - 1;
+      end
+      SatInt16: begin
+        lo = is_signed ? -(65'sd1 <<< 15) : '0;
+        hi = is_signed ?  (65'sd1 <<< 15) - 1 : (65'sd1 <<< 16) - 1;
+      end
+      SatPixel: begin
+        lo = '0;
+        hi = 65'sd255;
+      end
+      default: return x[31:0]; // SatNone
+    endcase
+    if (x < lo) return lo[31:0];
+    if (x > hi) return hi[31:0];
+    return x[31:0];
+  endfunction
+
+  // Handle the request and prepare the response data
+  logic [9:0] word_addr;
+  logic       we;
+  logic [ObiCfg.DataWidth-1:0] wdata;
+  assign word_addr = obi_req_i.a.addr[11:2];
+  assign we        = obi_req_i.a.we;
+  assign wdata     = obi_req_i.a.wdata;
+
+  // one dot product per cycle: A or the current coefficient word with wdata (or B for PROD)
+  logic        is_data, is_mac;
+  logic [31:0] dot_x, dot_y;
+  logic [1:0]  dot_elem;
+  logic [63:0] dot_res;
+  assign is_data  = (word_addr >= DataAddr) && (word_addr < DataAddr + DataWords);
+  assign is_mac   = (word_addr == MacAddr);
+  assign dot_x    = is_data ? coef_q[ptr_q] : a_q;
+  assign dot_y    = (is_data || is_mac) ? wdata : b_q;
+  assign dot_elem = (is_data || is_mac) ? elem_q : Elem32;
+  assign dot_res  = dot(dot_x, dot_y, dot_elem, a_signed_q, b_signed_q);
+
+  logic        res_signed;
+  logic [31:0] result;
+  assign res_signed = a_signed_q | b_signed_q;
+  assign result     = saturate($signed({res_signed & acc_q[63], acc_q}) >>> shift_q, sat_q,
+                               res_signed);
+
+  logic [PtrWidth-1:0] ptr_next;
+  assign ptr_next = (ptr_q == PtrWidth'(CoefWords-1)) ? '0 : ptr_q + 1;
+
+  always_comb begin
+    rsp_data_d = '0;
+    rsp_err_d  = '0;
+
+    a_d        = a_q;
+    b_d        = b_q;
+    a_signed_d = a_signed_q;
+    b_signed_d = b_signed_q;
+    elem_d     = elem_q;
+    sat_d      = sat_q;
+    shift_d    = shift_q;
+    acc_d      = acc_q;
+    ptr_d      = ptr_q;
+    coef_d     = coef_q;
+
+    if (obi_req_i.req) begin
+      if (is_data) begin
+        if (we) begin
+          acc_d = acc_q + dot_res;
+          ptr_d = ptr_next;
+        end else begin
+          rsp_data_d = result;
+        end
+      end else if (word_addr >= CoefAddr && word_addr < CoefAddr + CoefWords) begin
+        if (we) begin
+          coef_d[word_addr[PtrWidth-1:0]] = wdata;
+        end else begin
+          rsp_data_d = coef_q[word_addr[PtrWidth-1:0]];
+        end
+      end else begin
+        case (word_addr)
+          AAddr: begin
+            if (we) a_d = wdata;
+            else    rsp_data_d = a_q;
+          end
+          BAddr: begin
+            if (we) b_d = wdata;
+            else    rsp_data_d = b_q;
+          end
+          ProdLoAddr: begin
+            if (we) rsp_err_d = '1;
+            else    rsp_data_d = dot_res[31:0];
+          end
+          ProdHiAddr: begin
+            if (we) rsp_err_d = '1;
+            else    rsp_data_d = dot_res[63:32];
+          end
+          CfgAddr: begin
+            if (we) begin
+              a_signed_d = wdata[0];
+              b_signed_d = wdata[1];
+              elem_d     = (wdata[3:2] == 2'd3) ? Elem32 : wdata[3:2];
+              sat_d      = wdata[5:4];
+              shift_d    = wdata[13:8];
+            end else begin
+              rsp_data_d = {18'h0, shift_q, 2'b00, sat_q, elem_q, b_signed_q, a_signed_q};
+            end
+          end
+          AccLoAddr: begin
+            if (we) begin
+              acc_d = {{32{res_signed & wdata[31]}}, wdata};
+              ptr_d = '0;
+            end else begin
+              rsp_data_d = acc_q[31:0];
+            end
+          end
+          AccHiAddr: begin
+            if (we) rsp_err_d = '1;
+            else    rsp_data_d = acc_q[63:32];
+          end
+          ResultAddr: begin
+            if (we) rsp_err_d = '1;
+            else    rsp_data_d = result;
+          end
+          MacAddr: begin
+            if (we) begin
+              b_d   = wdata;
+              acc_d = acc_q + dot_res;
+            end else begin
+              rsp_err_d = '1;
+            end
+          end
+          PtrAddr: begin
+            if (we) ptr_d = (wdata < CoefWords) ? wdata[PtrWidth-1:0] : '0;
+            else    rsp_data_d = 32'(ptr_q);
+          end
+          default: rsp_err_d = '1;
+        endcase
+      end
+    end
+  end
+
+  // Wire the response
+  // A channel
+  assign obi_rsp_o.gnt = obi_req_i.req;
+  // R channel:
+  assign obi_rsp_o.rvalid = req_q;
+  assign obi_rsp_o.r.rdata = rsp_data_q;
+  assign obi_rsp_o.r.rid = id_q;
+  assign obi_rsp_o.r.err = rsp_err_q;
+  assign obi_rsp_o.r.r_optional = '0;
+
+endmodule
@@ -14,7 +14,10 @@ package user_pkg;
   // User Manager Address maps //
   ///////////////////////////////
   
-  // None
+  // None, the DMA engine is the only manager and directly drives the crossbar port
+
+  // Maximum number of outstanding requests of the DMA engine
+  localparam int unsigned UserDmaNumMaxTrans = 4;
 
   /////////////////////////////////////
   // User Subordinate Address maps ////
@@ -22,12 +25,24 @@ package user_pkg;
 
   // TODO 2: Declare a unique index for the UserROM memory domain and modify this file accordingly
 
-  localparam int unsigned NumUserDomainSubordinates = 2;
+  localparam int unsigned NumUserDomainSubordinates = 4;
 
   localparam bit [31:0] UserRomAddrOffset   = croc_pkg::UserBaseAddr; // 32'h2000_0000;
   localparam bit [31:0] UserRomAddrRange    = 32'h0000_1000;          // every subordinate has at least 4KB
   localparam bit [31:0] UserEdgeDetectAddrOffset = 32'h2000_1000;
   localparam bit [31:0] UserEdgeDetectAddrRange = 32'h0000_1000;
+  localparam bit [31:0] UserDmaAddrOffset = 32'h2000_2000;
+  localparam bit [31:0] UserDmaAddrRange  = 32'h0000_1000;
+  localparam bit [31:0] UserMacAddrOffset = 32'h2000_3000;
+  localparam bit [31:0] UserMacAddrRange  = 32'h0000_1000;
+
+  // Number of coefficient words of the MAC unit vector mode, 0 removes the unit (its address
+  // range then answers with errors)
+`ifdef USER_MAC_COEF_WORDS
+  localparam int unsigned UserMacCoefWords = `USER_MAC_COEF_WORDS;
+`else
+  localparam int unsigned UserMacCoefWords = 16;
+`endif
 
 
   localparam int unsigned NumDemuxSbrRules  = NumUserDomainSubordinates; // number of address rules in the decoder
@@ -37,12 +52,16 @@ package user_pkg;
   typedef enum int {
     UserError = 0,
     UserRom = 1,
-    UserEdgeDetect = 2
+    UserEdgeDetect = 2,
+    UserDma = 3,
+    UserMac = 4
   } user_demux_outputs_e;
 
   // Address rules given to address decoder
   // UserError does not appear as it will be used as default rule
   localparam croc_pkg::addr_map_rule_t [NumDemuxSbrRules-1:0] user_addr_map = '{
+    '{ idx:UserMac, start_addr: UserMacAddrOffset, end_addr: UserMacAddrOffset + UserMacAddrRange},
+    '{ idx:UserDma, start_addr: UserDmaAddrOffset, end_addr: UserDmaAddrOffset + UserDmaAddrRange},
     '{ idx:UserEdgeDetect, start_addr: UserEdgeDetectAddrOffset, end_addr: UserEdgeDetectAddrOffset + UserEdgeDetectAddrRange},
     '{ idx:UserRom, start_addr: UserRomAddrOffset, end_addr: UserRomAddrOffset + UserRomAddrRange}
   };
@@ -0,0 +1,119 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Arithmetic kernels of the runtime library (lib/inc/arith.h) against the plain C they replace,
+// which the compiler turns into libgcc calls (*_libgcc).
+
+#include "uart.h"
+#include "util.h"
+#include "bench.h"
+#include "arith.h"
+
+#define OPERANDS 16
+
+// small operands (up to 8 bits, like pixels and loop counters) and full 32 bit ones
+uint32_t small_a[OPERANDS], small_b[OPERANDS];
+uint32_t large_a[OPERANDS], large_b[OPERANDS];
+fx16_t fx_a[OPERANDS], fx_b[OPERANDS];
+volatile uint32_t sink;
+
+void init_data(void) {
+    uint32_t x = 0x12345678;
+    for (uint32_t i = 0; i < OPERANDS; i++) {
+        // xorshift, no multiplication
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        small_a[i] = x & 0xFF;
+        small_b[i] = (x >> 8) & 0x3F;
+        large_a[i] = x;
+        large_b[i] = (x >> 7) | 1;
+        fx_a[i]    = (fx16_t)x >> 10;
+        fx_b[i]    = (fx16_t)(x << 3) >> 12;
+    }
+}
+
+void bench_mul_small_libgcc(void *arg) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < OPERANDS; i++) acc += small_a[i] * small_b[i];
+    sink = acc;
+}
+
+void bench_mul_small(void *arg) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < OPERANDS; i++) acc += mul32(small_a[i], small_b[i]);
+    sink = acc;
+}
+
+void bench_mul_libgcc(void *arg) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < OPERANDS; i++) acc += large_a[i] * large_b[i];
+    sink = acc;
+}
+
+void bench_mul(void *arg) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < OPERANDS; i++) acc += mul32(large_a[i], large_b[i]);
+    sink = acc;
+}
+
+// large dividends by small divisors, quotient and remainder
+void bench_div_libgcc(void *arg) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < OPERANDS; i++) acc += large_a[i] / (small_b[i] + 1) + large_a[i] % (small_b[i] + 1);
+    sink = acc;
+}
+
+void bench_div(void *arg) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < OPERANDS; i++) {
+        uint32_t rem;
+        acc += udivmod32(large_a[i], small_b[i] + 1, &rem) + rem;
+    }
+    sink = acc;
+}
+
+void bench_div10_libgcc(void *arg) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < OPERANDS; i++) acc += large_a[i] / 10;
+    sink = acc;
+}
+
+void bench_div10(void *arg) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < OPERANDS; i++) acc += divu10(large_a[i]);
+    sink = acc;
+}
+
+void bench_fxmul_libgcc(void *arg) {
+    fx16_t acc = 0;
+    for (uint32_t i = 0; i < OPERANDS; i++) acc += (fx16_t)(((int64_t)fx_a[i] * fx_b[i]) >> 16);
+    sink = acc;
+}
+
+void bench_fxmul(void *arg) {
+    fx16_t acc = 0;
+    for (uint32_t i = 0; i < OPERANDS; i++) acc += fx16_mul(fx_a[i], fx_b[i]);
+    sink = acc;
+}
+
+const bench_t benches[] = {
+    {"mul_small_libgcc", 0, bench_mul_small_libgcc, 0},
+    {"mul_small", 0, bench_mul_small, 0},
+    {"mul_libgcc", 0, bench_mul_libgcc, 0},
+    {"mul", 0, bench_mul, 0},
+    {"div_libgcc", 0, bench_div_libgcc, 0},
+    {"div", 0, bench_div, 0},
+    {"div10_libgcc", 0, bench_div10_libgcc, 0},
+    {"div10", 0, bench_div10, 0},
+    {"fxmul_libgcc", 0, bench_fxmul_libgcc, 0},
+    {"fxmul", 0, bench_fxmul, 0},
+};
+
+int main() {
+    uart_init();
+    init_data();
+    bench_run_all(benches, sizeof(benches) / sizeof(benches[0]));
+    return 1;
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Measures the copy throughput of the core against the user domain DMA engine.
+
+#include "uart.h"
+#include "print.h"
+#include "util.h"
+#include "bench.h"
+#include "dma.h"
+
+#define BENCH_WORDS 128
+
+uint32_t src_buf[BENCH_WORDS];
+uint32_t dst_buf[BENCH_WORDS];
+uint32_t errors;
+
+void fill(void *arg) {
+    uint32_t salt = (uint32_t)arg;
+    for (uint32_t i = 0; i < BENCH_WORDS; i++) {
+        src_buf[i] = i ^ salt;
+        dst_buf[i] = 0;
+    }
+}
+
+void check(uint32_t salt, int reversed) {
+    for (uint32_t i = 0; i < BENCH_WORDS; i++) {
+        uint32_t idx = reversed ? BENCH_WORDS - 1 - i : i;
+        if (dst_buf[idx] != (i ^ salt)) {
+            errors++;
+        }
+    }
+}
+
+// core load/store loop
+void cpu_copy(void *arg) {
+    for (uint32_t i = 0; i < BENCH_WORDS; i++) {
+        dst_buf[i] = src_buf[i];
+    }
+}
+
+// DMA, core waiting for completion
+void dma_copy(void *arg) {
+    errors += (dma_memcpy(dst_buf, src_buf, BENCH_WORDS) != 0);
+}
+
+// DMA with reversed destination order, showing negative strides
+void dma_reverse(void *arg) {
+    dma_start_strided((uintptr_t)&dst_buf[BENCH_WORDS - 1], -4, (uintptr_t)src_buf, 4,
+                      BENCH_WORDS, 0);
+    errors += (dma_wait() != 0);
+    dma_clear();
+}
+
+const bench_t benches[] = {
+    {"copy_cpu_128w", fill, cpu_copy, (void *)0x5A5A0000},
+    {"copy_dma_128w", fill, dma_copy, (void *)0xA5A50000},
+    {"reverse_dma_128w", fill, dma_reverse, (void *)0x3C3C0000},
+};
+
+int main() {
+    uart_init();
+    bench_run_all(benches, sizeof(benches) / sizeof(benches[0]));
+
+    // verify the results outside of the timed runs
+    fill((void *)0x5A5A0000);
+    cpu_copy(0);
+    check(0x5A5A0000, 0);
+    fill((void *)0xA5A50000);
+    dma_copy(0);
+    check(0xA5A50000, 0);
+    fill((void *)0x3C3C0000);
+    dma_reverse(0);
+    check(0x3C3C0000, 1);
+
+    printf("Errors: 0x%x\n", errors);
+    uart_write_flush();
+
+    return (errors == 0) ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Benchmarks small software kernels against the user domain accelerators.
+
+#include "uart.h"
+#include "util.h"
+#include "bench.h"
+#include "edge_detect.h"
+#include "image_data.h"
+
+#define POPCOUNT_WORDS 8
+
+const uint32_t popcount_data[POPCOUNT_WORDS] = {0x7bdf967f, 0xa6c04951, 0x3f78fb58, 0x4d6a542b,
+                                                0x9f7898b2, 0x2d9e72ad, 0x1f4fcbde, 0x00000000};
+volatile uint32_t sink;
+uint8_t edges[IMAGE_SIZE] __attribute__((aligned(4)));
+
+/// @brief Example integer square root
+/// @return integer square root of n
+uint32_t isqrt(uint32_t n) {
+    uint32_t res = 0;
+    uint32_t bit = (uint32_t)1 << 30;
+
+    while (bit > n) bit >>= 2;
+
+    while (bit) {
+        if (n >= res + bit) {
+            n -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+void bench_isqrt(void *arg) {
+    sink = isqrt((uint32_t)arg);
+}
+
+void bench_popcount_sw(void *arg) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < POPCOUNT_WORDS; i++) {
+        uint32_t n = popcount_data[i];
+        while (n) {
+            count += n & 1;
+            n >>= 1;
+        }
+    }
+    sink = count;
+}
+
+void bench_popcount_hw(void *arg) {
+    volatile uint32_t *bulk =
+        reg32(USER_EDGE_DETECT_BASE_ADDR, EDGE_DETECT_BITACC_BULK_REG_OFFSET);
+    *reg32(USER_EDGE_DETECT_BASE_ADDR, EDGE_DETECT_BITACC_CLEAR_REG_OFFSET) = 0;
+    for (uint32_t i = 0; i < POPCOUNT_WORDS; i++) {
+        bulk[i] = popcount_data[i];
+    }
+    sink = *reg32(USER_EDGE_DETECT_BASE_ADDR, EDGE_DETECT_BITACC_RESULT_REG_OFFSET);
+}
+
+void bench_sobel_hw(void *arg) {
+    edge_detect_frame(image_data, edges, IMAGE_WIDTH, IMAGE_HEIGHT);
+}
+
+const bench_t benches[] = {
+    {"isqrt", 0, bench_isqrt, (void *)1234567890UL},
+    {"popcount_sw", 0, bench_popcount_sw, 0},
+    {"popcount_hw", 0, bench_popcount_hw, 0},
+    {"sobel_hw_8x8", 0, bench_sobel_hw, 0},
+};
+
+int main() {
+    uart_init();
+    bench_run_all(benches, sizeof(benches) / sizeof(benches[0]));
+    return 1;
+}
@@ -0,0 +1,180 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// MAC / dot-product unit (lib/inc/mac.h) against libgcc multiplications (*_libgcc) and the
+// shift-and-add mul32 of the runtime library (*_mul32): a 16-bit dot product, a 64-bit product
+// and a 3x3 sharpening filter over the example image. The results are checked after the runs.
+
+#include "uart.h"
+#include "print.h"
+#include "util.h"
+#include "bench.h"
+#include "arith.h"
+#include "pixel.h"
+#include "mac.h"
+#include "image_data.h"
+
+#define DOT_LEN 32 // 16-bit elements
+// words of dot_a preloaded as coefficients, clamped to the coefficient storage of the unit
+#define DOT_VEC_WORDS (MAC_COEF_WORDS < DOT_LEN / 2 ? MAC_COEF_WORDS : DOT_LEN / 2)
+
+int16_t dot_a[DOT_LEN] __attribute__((aligned(4)));
+int16_t dot_b[DOT_LEN] __attribute__((aligned(4)));
+uint8_t conv_sw[IMAGE_SIZE] __attribute__((aligned(4)));
+uint8_t conv_hw[IMAGE_SIZE] __attribute__((aligned(4)));
+volatile int32_t dot_sw, dot_hw, dot_vec, dot_vec_sw;
+volatile uint64_t prod_sw, prod_hw;
+
+// sharpening kernel, one row per coefficient word (element 3 unused)
+static const int8_t kernel[3][3] = {{0, -1, 0}, {-1, 5, -1}, {0, -1, 0}};
+static uint32_t kernel_words[3];
+
+uint32_t errors = 0;
+
+void init_data(void) {
+    uint32_t x = 0x2468ACE1;
+    for (uint32_t i = 0; i < DOT_LEN; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        dot_a[i] = (int16_t)x >> 4;
+        dot_b[i] = (int16_t)(x >> 16) >> 4;
+    }
+    for (uint32_t r = 0; r < 3; r++)
+        kernel_words[r] = (uint8_t)kernel[r][0] | ((uint8_t)kernel[r][1] << 8) |
+                          ((uint8_t)kernel[r][2] << 16);
+}
+
+void bench_dot_libgcc(void *arg) {
+    int32_t acc = 0;
+    for (uint32_t i = 0; i < DOT_LEN; i++) acc += dot_a[i] * dot_b[i];
+    dot_sw = acc;
+}
+
+void bench_dot_mul32(void *arg) {
+    int32_t acc = 0;
+    for (uint32_t i = 0; i < DOT_LEN; i++) acc += smul32(dot_a[i], dot_b[i]);
+    dot_sw = acc;
+}
+
+// both vectors streamed, two products per MAC
+void setup_dot(void *arg) {
+    mac_config(mac_cfg_value(MAC_ELEM_16, MAC_SIGNED, MAC_SAT_INT32, 0));
+}
+
+void bench_dot_mac(void *arg) {
+    dot_hw = mac_dot((const uint32_t *)dot_a, (const uint32_t *)dot_b, DOT_LEN / 2);
+}
+
+// dot_a preloaded as coefficients, only dot_b streamed to the data window
+void setup_dot_vec(void *arg) {
+    setup_dot(arg);
+    mac_load_coefs((const uint32_t *)dot_a, DOT_VEC_WORDS);
+}
+
+void bench_dot_mac_vec(void *arg) {
+    mac_clear(0);
+    mac_stream((const uint32_t *)dot_b, DOT_VEC_WORDS);
+    dot_vec = mac_result();
+}
+
+void bench_mul64_libgcc(void *arg) {
+    prod_sw = (int64_t)(int32_t)(uintptr_t)arg * (int64_t)(int32_t)0x9E3779B9;
+}
+
+void setup_mul64(void *arg) {
+    mac_config(mac_cfg_value(MAC_ELEM_32, MAC_SIGNED, MAC_SAT_NONE, 0));
+}
+
+void bench_mul64_mac(void *arg) {
+    prod_hw = mac_mul64((uint32_t)(uintptr_t)arg, 0x9E3779B9);
+}
+
+// 3x3 filter of the inner pixels, the border is left at zero
+void bench_conv_libgcc(void *arg) {
+    for (uint32_t y = 1; y < IMAGE_HEIGHT - 1; y++) {
+        for (uint32_t x = 1; x < IMAGE_WIDTH - 1; x++) {
+            int32_t acc = 0;
+            for (uint32_t r = 0; r < 3; r++) {
+                const uint8_t *p = &image_data[(y + r - 1) * IMAGE_WIDTH + x - 1];
+                for (uint32_t c = 0; c < 3; c++) acc += kernel[r][c] * p[c];
+            }
+            conv_sw[y * IMAGE_WIDTH + x] = px_sat(acc);
+        }
+    }
+}
+
+// signed coefficients, unsigned pixels, four 8-bit products per MAC clamped to 0..255
+void setup_conv(void *arg) {
+    mac_config((1 << MAC_CFG_A_SIGNED_BIT) | mac_cfg_value(MAC_ELEM_8, 0, MAC_SAT_PIXEL, 0));
+    mac_load_coefs(kernel_words, 3);
+}
+
+void bench_conv_mac(void *arg) {
+    volatile uint32_t *base = reg32(USER_MAC_BASE_ADDR, 0);
+    volatile uint32_t *port = reg32(USER_MAC_BASE_ADDR, MAC_DATA_REG_OFFSET);
+    for (uint32_t y = 1; y < IMAGE_HEIGHT - 1; y++) {
+        for (uint32_t x = 1; x < IMAGE_WIDTH - 1; x++) {
+            const uint8_t *p = &image_data[(y - 1) * IMAGE_WIDTH + x - 1];
+            base[MAC_ACC_LO_REG_OFFSET / 4] = 0;
+            port[0] = p[0] | (p[1] << 8) | (p[2] << 16);
+            p += IMAGE_WIDTH;
+            port[1] = p[0] | (p[1] << 8) | (p[2] << 16);
+            p += IMAGE_WIDTH;
+            port[2] = p[0] | (p[1] << 8) | (p[2] << 16);
+            conv_hw[y * IMAGE_WIDTH + x] = port[0];
+        }
+    }
+}
+
+// without coefficient words the unit is not built (rtl/user_domain/user_domain.sv),
+// the filter needs one per kernel row
+const bench_t benches[] = {
+    {"dot16_libgcc", 0, bench_dot_libgcc, 0},
+    {"dot16_mul32", 0, bench_dot_mul32, 0},
+#if MAC_COEF_WORDS > 0
+    {"dot16_mac", setup_dot, bench_dot_mac, 0},
+    {"dot16_mac_vec", setup_dot_vec, bench_dot_mac_vec, 0},
+#endif
+    {"mul64_libgcc", 0, bench_mul64_libgcc, (void *)0x87654321},
+#if MAC_COEF_WORDS > 0
+    {"mul64_mac", setup_mul64, bench_mul64_mac, (void *)0x87654321},
+#endif
+    {"conv3x3_libgcc", 0, bench_conv_libgcc, 0},
+#if MAC_COEF_WORDS >= 3
+    {"conv3x3_mac", setup_conv, bench_conv_mac, 0},
+#endif
+};
+
+int main() {
+    uart_init();
+    init_data();
+    bench_run_all(benches, sizeof(benches) / sizeof(benches[0]));
+
+    // verify the results outside of the timed runs
+#if MAC_COEF_WORDS > 0
+    bench_dot_libgcc(0);
+    setup_dot_vec(0);
+    bench_dot_mac(0);
+    bench_dot_mac_vec(0);
+    dot_vec_sw = 0;
+    for (uint32_t i = 0; i < 2 * DOT_VEC_WORDS; i++) dot_vec_sw += dot_a[i] * dot_b[i];
+    errors += (dot_hw != dot_sw) + (dot_vec != dot_vec_sw);
+    bench_mul64_libgcc((void *)0x87654321);
+    setup_mul64(0);
+    bench_mul64_mac((void *)0x87654321);
+    errors += (prod_hw != prod_sw);
+#endif
+#if MAC_COEF_WORDS >= 3
+    bench_conv_libgcc(0);
+    setup_conv(0);
+    bench_conv_mac(0);
+    for (uint32_t i = 0; i < IMAGE_SIZE; i++) errors += (conv_hw[i] != conv_sw[i]);
+#endif
+
+    printf("Errors: 0x%x\n", errors);
+    uart_write_flush();
+
+    return (errors == 0) ? 1 : 0;
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Memory and bit counting kernels of the runtime library (lib/inc/mem.h, bitops.h) against
+// the byte loops and the bit-by-bit popcount they replace (*_bytes, popcount_bits).
+
+#include "uart.h"
+#include "util.h"
+#include "bench.h"
+#include "mem.h"
+#include "bitops.h"
+
+#define BUF_BYTES      128
+#define POPCOUNT_WORDS 32
+
+#define BYTE_LOOP __attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+
+uint8_t buf_src[BUF_BYTES] __attribute__((aligned(4)));
+uint8_t buf_dst[BUF_BYTES + 4] __attribute__((aligned(4)));
+uint32_t popcount_data[POPCOUNT_WORDS];
+volatile uint32_t sink;
+
+void init_data(void) {
+    for (uint32_t i = 0; i < BUF_BYTES; i++) buf_src[i] = i;
+    for (uint32_t i = 0; i < POPCOUNT_WORDS; i++) popcount_data[i] = i * 0x9E3779B9;
+}
+
+// the previous code
+BYTE_LOOP void copy_bytes(uint8_t *dst, const uint8_t *src, uint32_t n) {
+    while (n--) *dst++ = *src++;
+}
+
+BYTE_LOOP void set_bytes(uint8_t *dst, uint8_t c, uint32_t n) {
+    while (n--) *dst++ = c;
+}
+
+BYTE_LOOP int compare_bytes(const uint8_t *a, const uint8_t *b, uint32_t n) {
+    for (; n; n--, a++, b++) {
+        if (*a != *b) return *a - *b;
+    }
+    return 0;
+}
+
+void bench_memcpy_bytes(void *arg) {
+    copy_bytes(buf_dst, buf_src, (uint32_t)arg);
+}
+
+void bench_memcpy(void *arg) {
+    memcpy(buf_dst, buf_src, (uint32_t)arg);
+}
+
+// different alignment of source and destination, only bytes can be copied
+void bench_memcpy_unaligned(void *arg) {
+    memcpy(buf_dst + 1, buf_src, (uint32_t)arg);
+}
+
+void bench_memset_bytes(void *arg) {
+    set_bytes(buf_dst, 0xA5, (uint32_t)arg);
+}
+
+void bench_memset(void *arg) {
+    memset(buf_dst, 0xA5, (uint32_t)arg);
+}
+
+void setup_compare(void *arg) {
+    memcpy(buf_dst, buf_src, BUF_BYTES);
+}
+
+// equal buffers, the whole length is compared
+void bench_memcmp_bytes(void *arg) {
+    sink = compare_bytes(buf_dst, buf_src, (uint32_t)arg);
+}
+
+void bench_memcmp(void *arg) {
+    sink = memcmp(buf_dst, buf_src, (uint32_t)arg);
+}
+
+void bench_popcount_bits(void *arg) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < POPCOUNT_WORDS; i++) {
+        uint32_t n = popcount_data[i];
+        while (n) {
+            count += n & 1;
+            n >>= 1;
+        }
+    }
+    sink = count;
+}
+
+void bench_popcount32(void *arg) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < POPCOUNT_WORDS; i++) count += popcount32(popcount_data[i]);
+    sink = count;
+}
+
+void bench_popcount_words(void *arg) {
+    sink = popcount_words(popcount_data, POPCOUNT_WORDS);
+}
+
+const bench_t benches[] = {
+    {"memcpy_bytes", 0, bench_memcpy_bytes, (void *)BUF_BYTES},
+    {"memcpy", 0, bench_memcpy, (void *)BUF_BYTES},
+    {"memcpy_unaligned", 0, bench_memcpy_unaligned, (void *)BUF_BYTES},
+    {"memset_bytes", 0, bench_memset_bytes, (void *)BUF_BYTES},
+    {"memset", 0, bench_memset, (void *)BUF_BYTES},
+    {"memcmp_bytes", setup_compare, bench_memcmp_bytes, (void *)BUF_BYTES},
+    {"memcmp", setup_compare, bench_memcmp, (void *)BUF_BYTES},
+    {"popcount_bits", 0, bench_popcount_bits, 0},
+    {"popcount32", 0, bench_popcount32, 0},
+    {"popcount_words", 0, bench_popcount_words, 0},
+};
+
+int main() {
+    uart_init();
+    init_data();
+    bench_run_all(benches, sizeof(benches) / sizeof(benches[0]));
+    return 1;
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Saturating pixel kernels of the runtime library (lib/inc/pixel.h), four pixels per word,
+// against per-pixel C with branches (*_scalar) and libgcc multiplications (*_libgcc).
+
+#include "uart.h"
+#include "util.h"
+#include "bench.h"
+#include "pixel.h"
+
+#define PIXELS 64
+
+uint8_t px_a[PIXELS] __attribute__((aligned(4)));
+uint8_t px_b[PIXELS] __attribute__((aligned(4)));
+uint8_t px_dst[PIXELS] __attribute__((aligned(4)));
+
+void init_data(void) {
+    for (uint32_t i = 0; i < PIXELS; i++) {
+        px_a[i] = (i << 3) ^ 0x5A;
+        px_b[i] = (i << 2) + 0x40;
+    }
+}
+
+void bench_px_add_scalar(void *arg) {
+    for (uint32_t i = 0; i < PIXELS; i++) px_dst[i] = px_sat((int32_t)px_a[i] + px_b[i]);
+}
+
+void bench_px_add(void *arg) {
+    px_add_sat(px_dst, px_a, px_b, PIXELS);
+}
+
+void bench_px_absdiff_scalar(void *arg) {
+    for (uint32_t i = 0; i < PIXELS; i++)
+        px_dst[i] = px_a[i] > px_b[i] ? px_a[i] - px_b[i] : px_b[i] - px_a[i];
+}
+
+void bench_px_absdiff(void *arg) {
+    px_absdiff(px_dst, px_a, px_b, PIXELS);
+}
+
+void bench_px_scale_libgcc(void *arg) {
+    uint32_t gain = (uint32_t)arg;
+    for (uint32_t i = 0; i < PIXELS; i++) {
+        uint32_t p = px_a[i] * gain / 16;
+        px_dst[i]  = p > 255 ? 255 : p;
+    }
+}
+
+void bench_px_scale(void *arg) {
+    px_scale(px_dst, px_a, (uint32_t)arg, PIXELS);
+}
+
+void bench_px_threshold_scalar(void *arg) {
+    uint8_t threshold = (uint32_t)arg;
+    for (uint32_t i = 0; i < PIXELS; i++) px_dst[i] = px_a[i] >= threshold ? 255 : 0;
+}
+
+void bench_px_threshold(void *arg) {
+    px_threshold(px_dst, px_a, (uint32_t)arg, PIXELS);
+}
+
+const bench_t benches[] = {
+    {"px_add_scalar", 0, bench_px_add_scalar, 0},
+    {"px_add", 0, bench_px_add, 0},
+    {"px_absdiff_scalar", 0, bench_px_absdiff_scalar, 0},
+    {"px_absdiff", 0, bench_px_absdiff, 0},
+    {"px_scale_libgcc", 0, bench_px_scale_libgcc, (void *)24},
+    {"px_scale", 0, bench_px_scale, (void *)24},
+    {"px_threshold_scalar", 0, bench_px_threshold_scalar, (void *)0x80},
+    {"px_threshold", 0, bench_px_threshold, (void *)0x80},
+};
+
+int main() {
+    uart_init();
+    init_data();
+    bench_run_all(benches, sizeof(benches) / sizeof(benches[0]));
+    return 1;
+}
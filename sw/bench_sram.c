@@ -0,0 +1,77 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Typical firmware memory access patterns, the core fetches instructions while its loads and
+// stores hit the SRAM. The linker puts code and data into different banks (link.ld), sram_sum_bank0
+// sums an array placed in the code bank instead, where every load stalls a fetch.
+// `make bench-sram` compares contiguous with interleaved banks.
+// The crossbar performance counters of each kernel show the grant-wait cycles per port.
+
+#include "uart.h"
+#include "util.h"
+#include "bench.h"
+#include "perf.h"
+#include "bank.h"
+
+#define ARRAY_WORDS 64
+#define COPY_WORDS  32
+#define CALL_DEPTH  8
+
+uint32_t array[ARRAY_WORDS];
+uint32_t array_bank0[ARRAY_WORDS] SRAM_BANK(0);
+uint32_t copy_src[COPY_WORDS];
+uint32_t copy_dst[COPY_WORDS];
+volatile uint32_t sink;
+
+void init_data(void) {
+    for (uint32_t i = 0; i < ARRAY_WORDS; i++) array[i] = array_bank0[i] = i * 0x9E3779B9;
+    for (uint32_t i = 0; i < COPY_WORDS; i++) copy_src[i] = ~i;
+}
+
+// load-heavy loop over consecutive words
+void bench_sum(void *arg) {
+    const uint32_t *a = arg;
+    uint32_t sum      = 0;
+    for (uint32_t i = 0; i < ARRAY_WORDS; i++) sum += a[i];
+    sink = sum;
+}
+
+// one load and one store per word
+void bench_copy(void *arg) {
+    for (uint32_t i = 0; i < COPY_WORDS; i++) copy_dst[i] = copy_src[i];
+}
+
+// stack traffic of nested calls (return address and saved registers)
+__attribute__((noinline)) uint32_t call_chain(uint32_t depth, uint32_t acc) {
+    if (depth == 0) return acc;
+    return call_chain(depth - 1, acc * 3 + depth) + 1;
+}
+
+void bench_calls(void *arg) {
+    sink = call_chain(CALL_DEPTH, (uint32_t)arg);
+}
+
+const bench_t benches[] = {
+    {"sram_sum", 0, bench_sum, array},
+    {"sram_sum_bank0", 0, bench_sum, array_bank0},
+    {"sram_copy", 0, bench_copy, 0},
+    {"sram_calls", 0, bench_calls, (void *)7},
+};
+
+int main() {
+    uart_init();
+    init_data();
+    bench_run_all(benches, sizeof(benches) / sizeof(benches[0]));
+
+    // where the stalls come from: crossbar counters of one run of every kernel
+    perf_counters_t start, delta;
+    for (uint32_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+        perf_begin(&start);
+        benches[i].run(benches[i].arg);
+        perf_end(&start, &delta);
+        perf_report(benches[i].name, &delta);
+        uart_write_flush(); // no UART interrupts in the next region
+    }
+    return 1;
+}
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Generates the boot ROM (rtl/bootrom/boot_rom.sv) from the raw binary of sw/bootrom/bootrom.S.
+# Usage: gen_bootrom.py <bootrom.bin> > boot_rom.sv
+
+import argparse
+import sys
+
+TEMPLATE = """\
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Generated by sw/bootrom/gen_bootrom.py from sw/bootrom/bootrom.S (make -C sw bootrom),
+// do not edit.
+
+`include "common_cells/registers.svh"
+
+// Boot ROM holding the UART boot loader, see sw/bootrom/bootrom.S
+// Read-only, answers one cycle after the request, writes return an error.
+module boot_rom #(
+  /// The OBI configuration for all ports.
+  parameter obi_pkg::obi_cfg_t ObiCfg    = obi_pkg::ObiDefaultConfig,
+  /// The request struct.
+  parameter type               obi_req_t = logic,
+  /// The response struct.
+  parameter type               obi_rsp_t = logic
+) (
+  input  logic clk_i,
+  input  logic rst_ni,
+
+  /// OBI request interface
+  input  obi_req_t obi_req_i,
+  /// OBI response interface
+  output obi_rsp_t obi_rsp_o
+);
+
+  localparam int unsigned NumWords  = {num_words};
+  localparam int unsigned AddrWidth = {addr_width};
+
+  logic req_q, we_q;
+  logic [ObiCfg.IdWidth-1:0] id_q;
+  logic [AddrWidth-1:0] word_addr_q;
+  logic [ObiCfg.DataWidth-1:0] rom_data;
+
+  `FF(req_q,       obi_req_i.req,                   '0, clk_i, rst_ni)
+  `FF(we_q,        obi_req_i.a.we,                  '0, clk_i, rst_ni)
+  `FF(id_q,        obi_req_i.a.aid,                 '0, clk_i, rst_ni)
+  `FF(word_addr_q, obi_req_i.a.addr[2+:AddrWidth],  '0, clk_i, rst_ni)
+
+  always_comb begin
+    rom_data = '0;
+    unique case (word_addr_q)
+{cases}
+      default: rom_data = '0;
+    endcase
+  end
+
+  // A channel:
+  assign obi_rsp_o.gnt = obi_req_i.req;
+  // R channel:
+  assign obi_rsp_o.rvalid = req_q;
+  assign obi_rsp_o.r.rdata = rom_data;
+  assign obi_rsp_o.r.rid = id_q;
+  assign obi_rsp_o.r.err = we_q;
+  assign obi_rsp_o.r.r_optional = '0;
+
+endmodule
+"""
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("binary", help="raw binary of the boot ROM (objcopy -O binary)")
+    args = parser.parse_args()
+
+    with open(args.binary, "rb") as f:
+        data = f.read()
+    data += b"\0" * (-len(data) % 4)
+    words = [int.from_bytes(data[i:i + 4], "little") for i in range(0, len(data), 4)]
+    addr_width = max((len(words) - 1).bit_length(), 1)
+
+    cases = "\n".join(f"      {addr_width}'h{i:0{(addr_width + 3) // 4}x}: rom_data = 32'h{w:08x};"
+                      for i, w in enumerate(words))
+    sys.stdout.write(TEMPLATE.format(num_words=len(words), addr_width=addr_width, cases=cases))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
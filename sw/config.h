@@ -8,14 +8,28 @@
 #pragma once
 
 // Address map
+#define BOOTROM_BASE_ADDR 0x02000000
 #define SOCCTRL_BASE_ADDR 0x03000000
 #define UART_BASE_ADDR    0x03002000
 #define GPIO_BASE_ADDR    0x03005000
 #define TIMER_BASE_ADDR   0x0300A000
+#define PERF_BASE_ADDR    0x0300B000
+
+// SRAM, banks as configured in rtl/croc_pkg.sv (passed by the Makefile)
+#define SRAM_BASE_ADDR 0x10000000
+#ifndef SRAM_NUM_BANKS
+#define SRAM_NUM_BANKS 2
+#endif
+#ifndef SRAM_BANK_SIZE
+#define SRAM_BANK_SIZE 2048
+#endif
 
 // Edge detection
 #define USER_ROM_BASE_ADDR 0x20000000 
 #define USER_SETBITCOUNT_BASE_ADDR 0x20001000
+#define USER_EDGE_DETECT_BASE_ADDR 0x20001000
+#define USER_DMA_BASE_ADDR 0x20002000
+#define USER_MAC_BASE_ADDR 0x20003000
 
 // Frequencies
 #define TB_FREQUENCY 20000000
@@ -25,4 +39,6 @@
 // UART
 #define UART_BYTE_ALIGN 4
 #define UART_FREQ       TB_FREQUENCY
-#define UART_BAUD       TB_BAUDRATE
\ No newline at end of file
+#define UART_BAUD       TB_BAUDRATE
+// Timer
+#define TIMER_FREQ      TB_FREQUENCY
\ No newline at end of file
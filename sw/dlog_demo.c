@@ -0,0 +1,41 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Logs the same messages with printf and with deferred logging (lib/inc/dlog.h) and compares
+// the time until the UART is idle again. `make dlog DLOG_PROGRAM=dlog_demo` decodes the output.
+
+#include "uart.h"
+#include "print.h"
+#include "util.h"
+#include "dlog.h"
+
+#define STEPS 8
+
+static const char *const phases[] = {"warmup", "run"};
+
+int main() {
+    uart_init();
+
+    uint32_t value = 1;
+    uint32_t start = get_mcycle();
+    for (uint32_t i = 0; i < STEPS; i++) {
+        value = (value << 3) ^ (value >> 2) ^ i;
+        printf("step %x: value %x\n", i, value);
+    }
+    uart_write_flush();
+    uint32_t printf_cycles = get_mcycle() - start;
+
+    value = 1;
+    start = get_mcycle();
+    for (uint32_t i = 0; i < STEPS; i++) {
+        value = (value << 3) ^ (value >> 2) ^ i;
+        DLOG("step %u (%s): value %u, delta %d\n", i, phases[i >= 2], value, (int32_t)(value - i));
+    }
+    uart_write_flush();
+    uint32_t dlog_cycles = get_mcycle() - start;
+
+    DLOG("printf: %u cycles, dlog: %u cycles\n", printf_cycles, dlog_cycles);
+    uart_write_flush();
+    return 1;
+}
@@ -8,7 +8,8 @@
 #define IMAGE_SIZE   (IMAGE_WIDTH * IMAGE_HEIGHT)
 
 // Example 8x8 grayscale image data (values 0-255)
-const uint8_t image_data[IMAGE_SIZE] = {
+// word aligned so rows can be streamed to the accelerator with 32-bit accesses
+const uint8_t image_data[IMAGE_SIZE] __attribute__((aligned(4))) = {
     0,  32,  64,  96, 128, 160, 192, 224,
    32,  64,  96, 128, 160, 192, 224, 255,
    64,  96, 128, 160, 192, 224, 255, 224,
@@ -0,0 +1,64 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Measures interrupt entry and exit latency in mcycles. The interrupt is triggered by enabling
+// the UART THR empty interrupt while the transmitter is idle, which raises it right away.
+
+#include "uart.h"
+#include "print.h"
+#include "util.h"
+#include "irq.h"
+
+#define NUM_RUNS 8
+
+volatile uint32_t t_handler;
+volatile uint32_t ecalls;
+
+void bench_handler(uint32_t cause) {
+    t_handler = get_mcycle();
+    *reg8(UART_BASE_ADDR, UART_INTR_ENABLE_REG_OFFSET) = 0;
+}
+
+uint32_t ecall_handler(uint32_t mcause, uint32_t mepc, uint32_t mtval) {
+    ecalls++;
+    return mepc + 4; // skip the ecall
+}
+
+int main() {
+    uart_init();
+    uart_write_flush();
+
+    uint32_t entry_min = ~0u, entry_max = 0;
+    uint32_t exit_min  = ~0u, exit_max  = 0;
+
+    irq_register(IRQ_UART, bench_handler);
+    for (int i = 0; i < NUM_RUNS; i++) {
+        uint32_t t0 = get_mcycle();
+        *reg8(UART_BASE_ADDR, UART_INTR_ENABLE_REG_OFFSET) = (1 << UART_INTR_ENABLE_THRE_BIT);
+        while (*reg8(UART_BASE_ADDR, UART_INTR_ENABLE_REG_OFFSET))
+            ;
+        uint32_t t1 = get_mcycle();
+        uint32_t entry = t_handler - t0;
+        uint32_t exit  = t1 - t_handler;
+        entry_min = MIN(entry_min, entry);
+        entry_max = entry > entry_max ? entry : entry_max;
+        exit_min  = MIN(exit_min, exit);
+        exit_max  = exit > exit_max ? exit : exit_max;
+    }
+
+    exception_register(ecall_handler);
+    uint32_t t2 = get_mcycle();
+    asm volatile("ecall" ::: "memory");
+    uint32_t t3 = get_mcycle();
+    exception_register(0);
+
+    // back to the regular driver
+    uart_init();
+    printf("IRQ entry: min 0x%x, max 0x%x cycles\n", entry_min, entry_max);
+    printf("IRQ exit: min 0x%x, max 0x%x cycles\n", exit_min, exit_max);
+    printf("ecall round trip: 0x%x cycles (0x%x calls)\n", t3 - t2, ecalls);
+    uart_write_flush();
+
+    return 1;
+}
@@ -0,0 +1,78 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+// Integer and fixed-point arithmetic for a core without M extension. Without it GCC calls
+// libgcc for every '*', '/' and '%' with a variable operand (__mulsi3 walks all bits of one
+// operand, __udivsi3 and 64 bit products are slower still). These kernels do less work when
+// the operands are small, multiplications by constants are left to the compiler (it already
+// expands them into shifts and adds).
+
+// product, loops over the smaller operand two bits at a time
+uint32_t mul32(uint32_t a, uint32_t b);
+
+// signed product, loops over the smaller magnitude
+int32_t smul32(int32_t a, int32_t b);
+
+// full 64 bit product from four 16x16 bit products
+uint64_t mul64(uint32_t a, uint32_t b);
+int64_t smul64(int32_t a, int32_t b);
+
+// quotient and remainder (rem may be NULL) of a restoring division that only iterates over
+// the quotient bits, powers of two are shifted. Division by zero returns all ones and n as
+// remainder, like the RISC-V div instruction.
+uint32_t udivmod32(uint32_t n, uint32_t d, uint32_t *rem);
+
+// division by constants with shifts and adds (Hacker's Delight, exact for all inputs)
+static inline uint32_t divu3(uint32_t n) {
+    uint32_t q = (n >> 2) + (n >> 4);
+    q = q + (q >> 4);
+    q = q + (q >> 8);
+    q = q + (q >> 16);
+    uint32_t r = n - ((q << 1) + q);
+    return q + ((((r << 3) + (r << 1) + r)) >> 5); // q + 11 * r / 32
+}
+
+static inline uint32_t divu10(uint32_t n) {
+    uint32_t q = (n >> 1) + (n >> 2);
+    q = q + (q >> 4);
+    q = q + (q >> 8);
+    q = q + (q >> 16);
+    q = q >> 3;
+    uint32_t r = n - (((q << 2) + q) << 1);
+    return q + (r > 9);
+}
+
+// Q16.16 fixed point
+typedef int32_t fx16_t;
+
+#define FX16_ONE  ((fx16_t)1 << 16)
+#define FX16_HALF ((fx16_t)1 << 15)
+
+static inline fx16_t fx16_from_int(int32_t i) {
+    return (fx16_t)((uint32_t)i << 16);
+}
+
+// rounds towards minus infinity
+static inline int32_t fx16_to_int(fx16_t x) {
+    return x >> 16;
+}
+
+// rounds to the nearest integer, halves up
+static inline int32_t fx16_round(fx16_t x) {
+    return (x + FX16_HALF) >> 16;
+}
+
+// product, the fraction is truncated
+static inline fx16_t fx16_mul(fx16_t a, fx16_t b) {
+    return (fx16_t)(smul64(a, b) >> 16);
+}
+
+// product with an integer, which usually has few bits
+static inline fx16_t fx16_mul_int(fx16_t a, int32_t i) {
+    return smul32(a, i);
+}
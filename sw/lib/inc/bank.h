@@ -0,0 +1,41 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+#include "../../config.h"
+
+// SRAM bank placement (see link.ld)
+//
+// By default the code is linked into bank 0 and the data, bss and stack into bank 1, so the
+// instruction fetches and the loads/stores of the core do not compete for the same bank.
+// Single variables and functions can be placed in a given bank explicitly:
+//   uint32_t buf[64] SRAM_BANK(0);        // data in the code bank, e.g. for DMA next to the core
+//   void isr(void) SRAM_BANK_TEXT(1);     // code in the data bank
+// Placed objects go to the start of their bank (in bank 0 right after the startup code), the
+// link fails if they do not fit there.
+// Data in SRAM_BANK sections is part of the binary (no zero-initialized .bss).
+// The bank of an address is only meaningful with contiguous banks (croc_pkg::SramBankInterleave).
+//
+// After linking, bin/<program>.banks reports the usage of every bank.
+
+#define SRAM_BANK(n)      __attribute__((section(".bank" #n)))
+#define SRAM_BANK_TEXT(n) __attribute__((section(".bank" #n ".text")))
+
+#define SRAM_SIZE (SRAM_NUM_BANKS * SRAM_BANK_SIZE)
+
+// linker symbols
+extern char __text_end[], __data_start[], __bss_start[], __bss_end[];
+extern char __stack_limit[], __sram_end[];
+
+// bank of an SRAM address (contiguous banks)
+static inline uint32_t sram_bank(const void *addr) {
+    return ((uint32_t)addr - SRAM_BASE_ADDR) / SRAM_BANK_SIZE;
+}
+
+// start address of a bank
+static inline void *sram_bank_base(uint32_t bank) {
+    return (void *)(SRAM_BASE_ADDR + bank * SRAM_BANK_SIZE);
+}
@@ -0,0 +1,49 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+// Cycle-accurate benchmark harness
+//
+// A benchmark program registers its kernels in a table of bench_t and passes it to
+// bench_run_all. Every kernel is run untimed for a number of warm-up iterations, then
+// timed for a number of repetitions with mcycle and minstret. The measured overhead of
+// an empty kernel is subtracted. Interrupts are disabled while a kernel is timed.
+//
+// Each kernel prints one result line over the UART, all numbers in hexadecimal:
+// BENCH,<name>,<reps>,<cycles_min>,<cycles_median>,<instret_min>,<instret_median>,<cpi_x1000>
+// `make bench` collects these lines of all sw/bench_*.c programs into a CSV file.
+
+#define BENCH_WARMUP   1  // default number of untimed warm-up runs
+#define BENCH_REPS     5  // default number of timed repetitions
+#define BENCH_MAX_REPS 16 // upper limit for the number of timed repetitions
+
+typedef struct {
+    const char *name;          // printed in the result line, must not contain ',' or '%'
+    void (*setup)(void *arg);  // optional (NULL), runs untimed before every run of the kernel
+    void (*run)(void *arg);    // the timed kernel
+    void *arg;                 // passed to setup and run
+} bench_t;
+
+typedef struct {
+    uint32_t reps;
+    uint32_t cycles_min;
+    uint32_t cycles_median;
+    uint32_t instret_min;
+    uint32_t instret_median;
+} bench_result_t;
+
+// run one kernel, reps is clamped to BENCH_MAX_REPS
+void bench_run(const bench_t *bench, uint32_t warmup, uint32_t reps, bench_result_t *result);
+
+// print the result line of one kernel
+void bench_report(const char *name, const bench_result_t *result);
+
+// run and report all kernels with the default warm-up and repetitions
+void bench_run_all(const bench_t *benches, uint32_t count);
+
+// cycles per instruction times 1000 (0 if no instruction retired)
+uint32_t bench_cpi_x1000(uint32_t cycles, uint32_t instret);
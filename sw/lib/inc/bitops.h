@@ -0,0 +1,27 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+// Bit counting without a multiplier (the core has no M extension, __builtin_popcount ends up
+// in a libgcc loop).
+
+// number of set bits in a word: SWAR sums of 2, 4 and 8 bits, then the bytes are folded
+static inline uint32_t popcount32(uint32_t x) {
+    x = x - ((x >> 1) & 0x55555555);
+    x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+    x = (x + (x >> 4)) & 0x0F0F0F0F;
+    x = x + (x >> 8);
+    x = x + (x >> 16);
+    return x & 0x3F;
+}
+
+// number of set bits in a byte, two lookups in a nibble table
+uint32_t popcount8(uint8_t x);
+
+// number of set bits in an array of words, the byte sums of up to 31 words are accumulated
+// before they are folded
+uint32_t popcount_words(const uint32_t *words, uint32_t count);
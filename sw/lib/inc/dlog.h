@@ -0,0 +1,63 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+// Deferred logging
+//
+// DLOG(fmt, ...) does not format anything on the target. The format string is placed in the
+// .dlog_fmt section, which the linker script keeps in the ELF but not in the loaded program,
+// and only a record is sent over the UART:
+//   DLOG_SYNC, varint(format id), one field per argument
+// The format id is the offset of the string in .dlog_fmt. Integer arguments (up to 32 bits,
+// including pointers and characters) are sent as the LEB128 varint of their 32-bit value, so
+// small values take one byte and negative ones five. Arguments of type char * are sent as the
+// string followed by a zero byte. sw/tools/dlog_decode.cpp turns a UART capture back into text
+// with the ELF; it supports %d %i %u %x %X %o %c %s %p %% with flags, width and precision.
+// Normal UART output (printf, uart_write) may be mixed with records, DLOG_SYNC never
+// appears in ASCII or UTF-8 text.
+//
+// At most DLOG_MAX_ARGS arguments, no 64-bit or floating point values. A record is sent with
+// interrupts disabled, so records of interrupt handlers never split those of the main program.
+
+#define DLOG_SYNC     0xFF
+#define DLOG_MAX_ARGS 8
+
+uint32_t dlog_begin(const char *fmt);
+void dlog_end(uint32_t irq_state);
+void dlog_u32(uint32_t value);
+void dlog_str(const char *str);
+
+static inline void dlog_ptr(const void *ptr) {
+    dlog_u32((uint32_t)(uintptr_t)ptr);
+}
+
+#define DLOG_ARG(x)                                                                             \
+    _Generic((x), char *: dlog_str, const char *: dlog_str, void *: dlog_ptr,                   \
+             const void *: dlog_ptr, default: dlog_u32)(x);
+
+#define DLOG_ARGS_0()
+#define DLOG_ARGS_1(a) DLOG_ARG(a)
+#define DLOG_ARGS_2(a, ...) DLOG_ARG(a) DLOG_ARGS_1(__VA_ARGS__)
+#define DLOG_ARGS_3(a, ...) DLOG_ARG(a) DLOG_ARGS_2(__VA_ARGS__)
+#define DLOG_ARGS_4(a, ...) DLOG_ARG(a) DLOG_ARGS_3(__VA_ARGS__)
+#define DLOG_ARGS_5(a, ...) DLOG_ARG(a) DLOG_ARGS_4(__VA_ARGS__)
+#define DLOG_ARGS_6(a, ...) DLOG_ARG(a) DLOG_ARGS_5(__VA_ARGS__)
+#define DLOG_ARGS_7(a, ...) DLOG_ARG(a) DLOG_ARGS_6(__VA_ARGS__)
+#define DLOG_ARGS_8(a, ...) DLOG_ARG(a) DLOG_ARGS_7(__VA_ARGS__)
+#define DLOG_COUNT(...) DLOG_COUNT_(_, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define DLOG_COUNT_(_, a1, a2, a3, a4, a5, a6, a7, a8, n, ...) n
+#define DLOG_CAT(a, b)  DLOG_CAT_(a, b)
+#define DLOG_CAT_(a, b) a##b
+
+// log a record, fmt must be a string literal
+#define DLOG(fmt, ...)                                                                          \
+    do {                                                                                        \
+        static const char _dlog_fmt[] __attribute__((section(".dlog_fmt"), used)) = fmt;        \
+        uint32_t _dlog_irq = dlog_begin(_dlog_fmt);                                             \
+        DLOG_CAT(DLOG_ARGS_, DLOG_COUNT(__VA_ARGS__))(__VA_ARGS__)                              \
+        dlog_end(_dlog_irq);                                                                    \
+    } while (0)
@@ -0,0 +1,46 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+#include "../../config.h"
+
+// Register offsets
+#define DMA_SRC_REG_OFFSET        0x00
+#define DMA_DST_REG_OFFSET        0x04
+#define DMA_LEN_REG_OFFSET        0x08
+#define DMA_SRC_STRIDE_REG_OFFSET 0x0C
+#define DMA_DST_STRIDE_REG_OFFSET 0x10
+#define DMA_CTRL_REG_OFFSET       0x14
+#define DMA_STATUS_REG_OFFSET     0x18
+
+// Register fields
+#define DMA_CTRL_START_BIT    0
+#define DMA_CTRL_IRQ_EN_BIT   1
+#define DMA_STATUS_BUSY_BIT   0
+#define DMA_STATUS_DONE_BIT   1
+#define DMA_STATUS_ERROR_BIT  2
+
+// All transfers move 32-bit words, addresses must be word aligned.
+// A stride of 0 repeatedly accesses the same address (e.g. a peripheral data register).
+
+// start a strided transfer of len words, returns immediately
+void dma_start_strided(uintptr_t dst, int32_t dst_stride, uintptr_t src, int32_t src_stride,
+                       uint32_t len, int irq_enable);
+
+// start a contiguous copy of len words, returns immediately
+void dma_start(void *dst, const void *src, uint32_t len);
+
+// returns non-zero while a transfer is in progress
+int dma_busy(void);
+
+// wait for the current transfer, returns 0 on success and -1 if an access failed
+int dma_wait(void);
+
+// clear the done and error flags (and with them the completion interrupt)
+void dma_clear(void);
+
+// blocking copy of len words
+int dma_memcpy(void *dst, const void *src, uint32_t len);
@@ -0,0 +1,44 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+#include "../../config.h"
+
+// Register offsets
+#define EDGE_DETECT_BITACC_CLEAR_REG_OFFSET  0x000
+#define EDGE_DETECT_BITACC_ADD_REG_OFFSET    0x004
+#define EDGE_DETECT_BITACC_RESULT_REG_OFFSET 0x008
+#define EDGE_DETECT_SOBEL_CFG_REG_OFFSET     0x010
+#define EDGE_DETECT_SOBEL_STATUS_REG_OFFSET  0x014
+#define EDGE_DETECT_SOBEL_PIXELS_REG_OFFSET  0x018
+#define EDGE_DETECT_SOBEL_OUT_REG_OFFSET     0x100
+#define EDGE_DETECT_BITACC_BULK_REG_OFFSET   0x200 // 64 words, write accumulates, read returns total
+#define EDGE_DETECT_BITACC_BULK_WORDS        64
+
+// Register fields
+#define EDGE_DETECT_SOBEL_CFG_WIDTH_BIT      0  // 7:0
+#define EDGE_DETECT_SOBEL_CFG_HEIGHT_BIT     16 // 23:16
+#define EDGE_DETECT_SOBEL_STATUS_ROWS_BIT    0  // 7:0
+#define EDGE_DETECT_SOBEL_STATUS_VALID_BIT   8
+#define EDGE_DETECT_SOBEL_STATUS_DONE_BIT    9
+
+// Largest supported frame width (MaxWidth parameter of user_edge_detect)
+#define EDGE_DETECT_MAX_WIDTH 64
+
+// Frames are stored row-major with one byte per pixel. Row buffers must be 4-byte aligned
+// and the width a multiple of 4 (between 4 and EDGE_DETECT_MAX_WIDTH, the hardware clamps it).
+
+// configure the frame size and restart the stream
+void edge_detect_init(uint32_t width, uint32_t height);
+
+// push the next row of the frame into the line buffers
+void edge_detect_push_row(const uint8_t *row, uint32_t width);
+
+// read the gradient magnitude of the row before the most recently pushed one
+void edge_detect_read_row(uint8_t *row, uint32_t width);
+
+// compute the gradient magnitude of a whole frame, border pixels are set to zero
+void edge_detect_frame(const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t height);
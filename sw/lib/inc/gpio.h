@@ -18,6 +18,26 @@
 #define GPIO_INTRPT_EN_REG_OFFSET     0x280
 #define GPIO_INTRPT_STATUS_REG_OFFSET 0x300
 #define GPIO_INTRPT_EDGE_REG_OFFSET   0x380
+// write-1-to-set / write-1-to-clear aliases, single store instead of read-modify-write
+#define GPIO_DIR_SET_REG_OFFSET       0x400
+#define GPIO_DIR_CLR_REG_OFFSET       0x480
+#define GPIO_EN_SET_REG_OFFSET        0x500
+#define GPIO_EN_CLR_REG_OFFSET        0x580
+#define GPIO_OUT_SET_REG_OFFSET       0x600
+#define GPIO_OUT_CLR_REG_OFFSET       0x680
+#define GPIO_INTRPT_EN_SET_REG_OFFSET 0x700
+#define GPIO_INTRPT_EN_CLR_REG_OFFSET 0x780
+// waveform engine
+#define GPIO_WAVE_CFG_REG_OFFSET      0x800
+#define GPIO_WAVE_MASK_REG_OFFSET     0x880
+#define GPIO_WAVE_DATA_REG_OFFSET     0x900
+#define GPIO_WAVE_STATUS_REG_OFFSET   0x980
+
+#define GPIO_WAVE_CFG_PERIOD_MASK     0xFFFF
+#define GPIO_WAVE_CFG_ENABLE_BIT      16
+#define GPIO_WAVE_STATUS_LEVEL_MASK   0xFFFF
+#define GPIO_WAVE_STATUS_EMPTY_BIT    16
+#define GPIO_WAVE_STATUS_FULL_BIT     17
 
 // functions applying to all 32 GPIOs with mask
 // a 1 in the mask applies action to this GPIO pin
@@ -50,3 +70,12 @@ void gpio_pin_enable_rising_interrupt(uint8_t gpio_pin);
 void gpio_pin_enable_falling_interrupt(uint8_t gpio_pin);
 void gpio_pin_disable_interrupts(uint8_t gpio_pin);
 uint8_t gpio_pin_get_interrupt_status(uint8_t gpio_pin);
+
+// waveform engine: queued patterns are applied to the masked outputs,
+// one every 'period' system clock cycles, without involving the core
+void gpio_wave_config(uint32_t period, uint32_t mask); // also enables the engine
+void gpio_wave_disable(void);
+uint32_t gpio_wave_push(uint32_t pattern); // returns 0 if the FIFO was full
+uint32_t gpio_wave_level(void);
+void gpio_wave_write(const uint32_t *patterns, uint32_t len); // blocks until all are queued
+void gpio_wave_flush(void); // blocks until the FIFO is empty
@@ -0,0 +1,83 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+#include "../../config.h"
+
+// Interrupt causes (mcause without the interrupt bit, equal to the mie/mip bit index)
+#define IRQ_TIMER        7  // timer 0 low compare (machine timer interrupt)
+#define IRQ_TIMER_HI     16 // timer 0 high compare (fast interrupt 0)
+#define IRQ_UART         17 // fast interrupt 1
+#define IRQ_GPIO         18 // fast interrupt 2
+#define IRQ_EXT(n)       (19 + (n)) // external interrupts from the user domain, n < 4
+#define IRQ_NUM          32
+
+// Exception causes (mcause with the interrupt bit clear)
+#define EXC_INSTR_ACCESS_FAULT 1
+#define EXC_ILLEGAL_INSTR      2
+#define EXC_BREAKPOINT         3
+#define EXC_LOAD_ACCESS_FAULT  5
+#define EXC_STORE_ACCESS_FAULT 7
+#define EXC_ECALL_M            11
+
+// Interrupts enter through the vector table in crt0.S, which saves the caller-saved registers
+// together with mepc/mstatus and calls the registered handler with global interrupts disabled.
+// Exceptions share vector 0 with the reset and are told apart by mcause.
+//
+// Fast path: a source with a handler defined by IRQ_FAST_HANDLER bypasses the common entry,
+// its vector jumps straight to the handler. The compiler saves only the registers the handler
+// uses (all caller-saved ones if it calls functions) and returns with mret, there is no
+// indirect call and no trap frame (irq_frame() is not set). Enable the source with
+// set_irq_enable, irq_register would route it to irq_handlers[] which the vector skips.
+//   IRQ_FAST_HANDLER(IRQ_GPIO) { ... }
+#define IRQ_FAST_HANDLER(cause) __IRQ_FAST_HANDLER(cause)
+#define __IRQ_FAST_HANDLER(cause) \
+    void __irq_vector_##cause(void) __attribute__((interrupt("machine"), used)); \
+    void __irq_vector_##cause(void)
+
+typedef void (*irq_handler_t)(uint32_t cause);
+
+// Trap frame word offsets, the interrupted registers as saved by the vector table
+#define IRQ_FRAME_RA      0
+#define IRQ_FRAME_MEPC    16
+#define IRQ_FRAME_MSTATUS 17
+
+// Trap frame of the interrupt being handled, only valid in a handler and the callbacks it
+// runs. A preempting interrupt (see irq_nest_enter) points it to its own frame and restores
+// it when it returns, exceptions leave it unchanged.
+extern const uint32_t *volatile __irq_frame;
+static inline const uint32_t *irq_frame(void) {
+    return __irq_frame;
+}
+
+// returns the pc to resume at (e.g. mepc + 4 to skip the faulting instruction)
+typedef uint32_t (*exception_handler_t)(uint32_t mcause, uint32_t mepc, uint32_t mtval);
+
+extern irq_handler_t irq_handlers[IRQ_NUM];
+
+// install a handler and enable the interrupt source
+void irq_register(uint32_t cause, irq_handler_t handler);
+
+// disable the interrupt source and restore the default handler
+void irq_unregister(uint32_t cause);
+
+// install an exception handler, 0 restores the default (report mcause as exit code and halt)
+void exception_register(exception_handler_t handler);
+
+// Nested interrupts: a handler may call irq_nest_enter to let other sources preempt it.
+// The sources in mask (at least its own one, level interrupts would re-enter otherwise) stay
+// masked until irq_nest_exit, which must be called before the handler returns.
+static inline uint32_t irq_nest_enter(uint32_t mask) {
+    uint32_t mie;
+    asm volatile("csrrc %0, mie, %1" : "=r"(mie) : "r"(mask) : "memory");
+    asm volatile("csrsi mstatus, 8" ::: "memory");
+    return mie;
+}
+
+static inline void irq_nest_exit(uint32_t mie) {
+    asm volatile("csrci mstatus, 8" ::: "memory");
+    asm volatile("csrw mie, %0" ::"r"(mie) : "memory");
+}
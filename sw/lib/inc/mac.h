@@ -0,0 +1,95 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+#include "../../config.h"
+#include "util.h"
+
+// Register offsets
+#define MAC_A_REG_OFFSET       0x000
+#define MAC_B_REG_OFFSET       0x004
+#define MAC_PROD_LO_REG_OFFSET 0x008
+#define MAC_PROD_HI_REG_OFFSET 0x00C
+#define MAC_CFG_REG_OFFSET     0x010
+#define MAC_ACC_LO_REG_OFFSET  0x014
+#define MAC_ACC_HI_REG_OFFSET  0x018
+#define MAC_RESULT_REG_OFFSET  0x01C
+#define MAC_MAC_REG_OFFSET     0x020
+#define MAC_PTR_REG_OFFSET     0x024
+#define MAC_COEF_REG_OFFSET    0x100 // MAC_COEF_WORDS words
+#define MAC_DATA_REG_OFFSET    0x200 // 64 words, write accumulates dot(COEF[PTR++], data)
+#define MAC_DATA_WORDS         64
+
+// Register fields
+#define MAC_CFG_A_SIGNED_BIT 0
+#define MAC_CFG_B_SIGNED_BIT 1
+#define MAC_CFG_ELEM_BIT     2 // 3:2
+#define MAC_CFG_SAT_BIT      4 // 5:4
+#define MAC_CFG_SHIFT_BIT    8 // 13:8
+
+#define MAC_ELEM_32 0 // one 32-bit element per word
+#define MAC_ELEM_16 1 // two 16-bit elements per word
+#define MAC_ELEM_8  2 // four 8-bit elements per word
+
+#define MAC_SAT_NONE  0 // RESULT is the low word of the shifted accumulator
+#define MAC_SAT_INT32 1 // clamped to the 32-bit range
+#define MAC_SAT_INT16 2 // clamped to the 16-bit range
+#define MAC_SAT_PIXEL 3 // clamped to 0..255
+
+#define MAC_SIGNED   ((1 << MAC_CFG_A_SIGNED_BIT) | (1 << MAC_CFG_B_SIGNED_BIT))
+#define MAC_UNSIGNED 0
+
+// Number of coefficient words (UserMacCoefWords in rtl/user_pkg.sv), set by the sw Makefile
+#ifndef MAC_COEF_WORDS
+#define MAC_COEF_WORDS 16
+#endif
+
+// Packed elements are stored with element 0 in the LSBs, as in a little endian array.
+// The vector functions take arrays of words (n words = n * elements products), 4-byte aligned.
+
+// CFG value of an element size, signedness (MAC_SIGNED/MAC_UNSIGNED), saturation and shift
+static inline uint32_t mac_cfg_value(uint32_t elem, uint32_t sign, uint32_t sat, uint32_t shift) {
+    return sign | (elem << MAC_CFG_ELEM_BIT) | (sat << MAC_CFG_SAT_BIT) | (shift << MAC_CFG_SHIFT_BIT);
+}
+
+static inline void mac_config(uint32_t cfg) {
+    *reg32(USER_MAC_BASE_ADDR, MAC_CFG_REG_OFFSET) = cfg;
+}
+
+// sets the accumulator (sign-extended if signed) and rewinds the coefficient pointer
+static inline void mac_clear(int32_t acc) {
+    *reg32(USER_MAC_BASE_ADDR, MAC_ACC_LO_REG_OFFSET) = acc;
+}
+
+// accumulator += dot(A, b) (set A with mac_set_a)
+static inline void mac_acc(uint32_t b) {
+    *reg32(USER_MAC_BASE_ADDR, MAC_MAC_REG_OFFSET) = b;
+}
+
+static inline void mac_set_a(uint32_t a) {
+    *reg32(USER_MAC_BASE_ADDR, MAC_A_REG_OFFSET) = a;
+}
+
+// shifted and saturated accumulator
+static inline int32_t mac_result(void) {
+    return *reg32(USER_MAC_BASE_ADDR, MAC_RESULT_REG_OFFSET);
+}
+
+// full 64-bit accumulator
+uint64_t mac_acc64(void);
+
+// full 64-bit product of a and b (32-bit elements, signedness of the configuration)
+uint64_t mac_mul64(uint32_t a, uint32_t b);
+
+// load n (at most MAC_COEF_WORDS) coefficient words
+void mac_load_coefs(const uint32_t *coefs, uint32_t n);
+
+// accumulator += sum of dot(COEF[ptr++], data[i]) over n words, the pointer wraps around
+// after MAC_COEF_WORDS words (or call mac_clear)
+void mac_stream(const uint32_t *data, uint32_t n);
+
+// dot product of n words of a and b, both streamed (A is written for every word)
+int32_t mac_dot(const uint32_t *a, const uint32_t *b, uint32_t n);
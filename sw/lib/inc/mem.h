@@ -0,0 +1,16 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Memory kernels with the standard names, so they also replace the byte-wise versions the
+// compiler calls for struct copies and initializers. Buffers with the same alignment (modulo 4)
+// are processed a word at a time, four words per loop iteration, the rest byte by byte.
+
+void *memcpy(void *dst, const void *src, size_t n);
+void *memset(void *dst, int c, size_t n);
+int memcmp(const void *a, const void *b, size_t n);
@@ -0,0 +1,92 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+#include "../../config.h"
+
+// Crossbar performance counters (rtl/perf_counters/perf_counters.sv)
+//
+// Counted per crossbar manager: accepted requests, cycles waiting for a grant, the sum of the
+// response latencies and the accepted requests per subordinate. To measure a code region:
+//   perf_counters_t start, delta;
+//   perf_begin(&start);
+//   ... region ...
+//   perf_end(&start, &delta);
+//   perf_report("region", &delta);
+// The accesses of perf_begin/perf_end themselves (a few data port requests to the peripherals)
+// are part of the deltas.
+//
+// perf_report prints one line per manager, all numbers in hexadecimal:
+// PERF,<name>,cycles,<cycles>
+// PERF,<name>,loop_cache,<hits>,<misses>
+// PERF,<name>,<manager>,<req>,<wait>,<lat>,<error>,<periph>,<bank0>,..,<bankN>,<user>
+
+// Register offsets
+#define PERF_CTRL_REG_OFFSET   0x000
+#define PERF_CYCLES_REG_OFFSET 0x004
+#define PERF_INFO_REG_OFFSET   0x008
+#define PERF_EVENT_REG_OFFSET(e) (0x040 + 4 * (e))
+#define PERF_MGR_REG_OFFSET(m) (0x100 + 0x40 * (m))
+#define PERF_REQ_REG_OFFSET    0x00 // within the manager block
+#define PERF_WAIT_REG_OFFSET   0x04
+#define PERF_LAT_REG_OFFSET    0x08
+#define PERF_SBR_REG_OFFSET(s) (0x10 + 4 * (s))
+
+// Register fields
+#define PERF_CTRL_ENABLE_BIT   0
+#define PERF_CTRL_CLEAR_BIT    1
+#define PERF_CTRL_SNAPSHOT_BIT 2
+
+// Crossbar managers (croc_pkg::croc_xbar_managers_e)
+#define PERF_MGR_USER  0
+#define PERF_MGR_DEBUG 1
+#define PERF_MGR_DATA  2
+#define PERF_MGR_INSTR 3
+#define PERF_NUM_MGR   4
+
+// Crossbar subordinates (croc_pkg::croc_xbar_outputs_e), one per SRAM bank
+// (the hardware reports its count in INFO[15:8])
+#define PERF_SBR_ERROR   0
+#define PERF_SBR_PERIPH  1
+#define PERF_SBR_BANK(n) (2 + (n))
+#define PERF_SBR_USER    (2 + SRAM_NUM_BANKS)
+#define PERF_NUM_SBR     (3 + SRAM_NUM_BANKS)
+
+// Event inputs (cycles each event was set)
+#define PERF_EVENT_LOOP_CACHE_HIT  0 // instruction fetch served by the loop cache
+#define PERF_EVENT_LOOP_CACHE_MISS 1 // cacheable fetch forwarded to the crossbar
+#define PERF_NUM_EVENTS            2
+
+typedef struct {
+    uint32_t req;  // accepted requests
+    uint32_t wait; // cycles waiting for a grant
+    uint32_t lat;  // sum of the response latencies in cycles
+    uint32_t sbr[PERF_NUM_SBR];
+} perf_mgr_t;
+
+typedef struct {
+    uint32_t cycles;
+    uint32_t events[PERF_NUM_EVENTS];
+    perf_mgr_t mgr[PERF_NUM_MGR];
+} perf_counters_t;
+
+// clear and start the counters
+void perf_start(void);
+
+// stop (freeze) the counters
+void perf_stop(void);
+
+// read a consistent snapshot of the counters, they keep running
+void perf_read(perf_counters_t *counters);
+
+// start the counters if needed and take the start snapshot of a region
+void perf_begin(perf_counters_t *start);
+
+// take the end snapshot of a region and return the difference to its start
+void perf_end(const perf_counters_t *start, perf_counters_t *delta);
+
+// print the counters (usually the delta of a region)
+void perf_report(const char *name, const perf_counters_t *counters);
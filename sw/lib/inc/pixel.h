@@ -0,0 +1,73 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+// Saturating 8 bit pixel arithmetic. The px4_* operations work on four pixels packed into a
+// word (SWAR), the carries between the bytes are masked out, so there is no need to unpack.
+// The buffer versions process four pixels per iteration: buffers must be 4-byte aligned,
+// a count that is not a multiple of 4 is finished pixel by pixel.
+
+#define PX4_MSB 0x80808080u
+#define PX4_LOW 0x7F7F7F7Fu
+
+// clamps to 0..255
+static inline uint8_t px_sat(int32_t x) {
+    return x < 0 ? 0 : x > 255 ? 255 : (uint8_t)x;
+}
+
+// 0xFF in every byte whose most significant bit is set in msbs (only PX4_MSB bits set)
+static inline uint32_t px4_mask(uint32_t msbs) {
+    return (msbs << 1) - (msbs >> 7);
+}
+
+// min(a + b, 255) per byte
+static inline uint32_t px4_add_sat(uint32_t a, uint32_t b) {
+    uint32_t sum   = ((a & PX4_LOW) + (b & PX4_LOW)) ^ ((a ^ b) & PX4_MSB);
+    uint32_t carry = ((a & b) | ((a | b) & ~sum)) & PX4_MSB;
+    return sum | px4_mask(carry);
+}
+
+// max(a - b, 0) per byte
+static inline uint32_t px4_sub_sat(uint32_t a, uint32_t b) {
+    uint32_t diff   = ((a | PX4_MSB) - (b & PX4_LOW)) ^ ((a ^ ~b) & PX4_MSB);
+    uint32_t borrow = ((~a & b) | (~(a ^ b) & diff)) & PX4_MSB;
+    return diff & ~px4_mask(borrow);
+}
+
+// |a - b| per byte
+static inline uint32_t px4_absdiff(uint32_t a, uint32_t b) {
+    return px4_sub_sat(a, b) | px4_sub_sat(b, a);
+}
+
+// (a + b) / 2 per byte, rounded down
+static inline uint32_t px4_avg(uint32_t a, uint32_t b) {
+    return (a & b) + (((a ^ b) & 0xFEFEFEFE) >> 1);
+}
+
+// max(a, b) and min(a, b) per byte
+static inline uint32_t px4_max(uint32_t a, uint32_t b) {
+    return b + px4_sub_sat(a, b);
+}
+
+static inline uint32_t px4_min(uint32_t a, uint32_t b) {
+    return a - px4_sub_sat(a, b);
+}
+
+// dst = min(a + b, 255)
+void px_add_sat(uint8_t *dst, const uint8_t *a, const uint8_t *b, uint32_t count);
+
+// dst = max(a - b, 0)
+void px_sub_sat(uint8_t *dst, const uint8_t *a, const uint8_t *b, uint32_t count);
+
+// dst = |a - b|
+void px_absdiff(uint8_t *dst, const uint8_t *a, const uint8_t *b, uint32_t count);
+
+// dst = min(src * gain / 16, 255), gain in 4.4 fixed point (16 is 1.0)
+void px_scale(uint8_t *dst, const uint8_t *src, uint8_t gain, uint32_t count);
+
+// dst = src >= threshold ? 255 : 0
+void px_threshold(uint8_t *dst, const uint8_t *src, uint8_t threshold, uint32_t count);
@@ -9,3 +9,4 @@
 #define SOC_CTRL_BOOTADDR_REG_OFFSET   0x00
 #define SOC_CTRL_FETCHEN_REG_OFFSET    0x04
 #define SOC_CTRL_CORESTATUS_REG_OFFSET 0x08
+#define SOC_CTRL_BOOTMODE_REG_OFFSET   0x0C
@@ -0,0 +1,46 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+#include "../../config.h"
+
+// Statistical sampling profiler
+//
+// A periodic software timer interrupts the program and counts the interrupted pc (or its
+// return address) in a histogram of SPROF_BUCKET_BYTES wide buckets over the SRAM. Unlike
+// the instruction trace (make profile) it runs on unmodified RTL and costs one short
+// interrupt per sample. Code running with interrupts disabled is not sampled, its samples
+// land on the instruction that re-enables them. Samples due while sampling was (re)started
+// or stopped with interrupts disabled are lost, <expected> (elapsed time / period) shows
+// how many samples there should have been.
+//
+// sprof_dump prints the histogram over the UART, all numbers in hexadecimal:
+// SPROF_BEGIN,<pc|ra>,<base>,<bucket_bytes>,<period_cycles>,<samples>,<expected>,<outside>
+// SPROF,<bucket_addr>,<count>        (one line per non-empty bucket)
+// SPROF_END
+// verilator/scripts/sprof.py turns this into a flat profile using the symbols of the ELF.
+
+#ifndef SPROF_BUCKET_SHIFT
+#define SPROF_BUCKET_SHIFT 5 // 32 byte buckets (8 instructions), 256 bytes of counters
+#endif
+
+#define SPROF_BASE         SRAM_BASE_ADDR
+#define SPROF_SIZE         (SRAM_NUM_BANKS * SRAM_BANK_SIZE)
+#define SPROF_BUCKET_BYTES (1 << SPROF_BUCKET_SHIFT)
+#define SPROF_BUCKETS      (SPROF_SIZE >> SPROF_BUCKET_SHIFT)
+
+// what is counted per sample
+#define SPROF_MODE_PC 0 // interrupted pc, time spent in each function itself
+#define SPROF_MODE_RA 1 // return address, attributes leaf functions to their call sites
+
+// clear the histogram and sample every period_us (well above the ~100 cycle handler cost)
+void sprof_start(uint32_t period_us, uint32_t mode);
+
+// stop sampling, the histogram is kept
+void sprof_stop(void);
+
+// print the histogram
+void sprof_dump(void);
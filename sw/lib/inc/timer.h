@@ -40,4 +40,48 @@
 #define CFG_HIGH_REG_PRESC_ENABLE_BIT 6
 #define CFG_HIGH_REG_CLOCK_SOURCE_BIT 7
 
+// The low counter runs freely on the system clock (TIMER_FREQ) and is the timebase, the high
+// counter is the alarm armed for the nearest software timer deadline only (tickless).
+// The alarm interrupt is a single-cycle pulse that is lost if interrupts are disabled at that
+// moment, so the alarm repeats every TIMER_ALARM_MAX_CYCLES at most until it is re-armed, and
+// deadlines closer than TIMER_ALARM_MARGIN cycles or already missed are run without it.
+#define TIMER_CYCLES_PER_US (TIMER_FREQ / 1000000)
+
+#ifndef TIMER_ALARM_MAX_CYCLES
+#define TIMER_ALARM_MAX_CYCLES (1000 * TIMER_CYCLES_PER_US)
+#endif
+#define TIMER_ALARM_MARGIN     64
+
+typedef void (*soft_timer_callback_t)(void *arg);
+
+typedef struct soft_timer {
+    struct soft_timer *next;        // deadline queue, sorted by deadline
+    uint32_t deadline;              // timebase value at which the timer expires
+    uint32_t period;                // reload in timebase cycles, 0 for one-shot timers
+    soft_timer_callback_t callback; // called with interrupts disabled, see soft_timer_in_irq
+    void *arg;
+    uint8_t active;
+} soft_timer_t;
+
+// start the timebase and register the alarm interrupt (done on first use as well)
+void timer_init(void);
+
+// current timebase value in system clock cycles, wraps after 2^32 cycles
+uint32_t timer_now(void);
+
+// start (or restart) a timer expiring after delay_us and then every period_us (0: one-shot)
+void soft_timer_start(soft_timer_t *timer, uint32_t delay_us, uint32_t period_us,
+                      soft_timer_callback_t callback, void *arg);
+
+// remove a timer from the deadline queue
+void soft_timer_stop(soft_timer_t *timer);
+
+// Callbacks normally run from the timer interrupt. A deadline that was missed (or too close to
+// arm the alarm for) is run from soft_timer_start/soft_timer_stop instead, where irq_frame()
+// does not hold the interrupted registers. Returns 1 in a callback run from the interrupt.
+int soft_timer_in_irq(void);
+
+// busy-wait on the timebase, interrupts (and timer callbacks) keep being served
+void sleep_us(uint32_t us);
+
 void sleep_ms(uint32_t ms);
@@ -30,9 +30,35 @@
 
 // Register fields
 #define UART_LINE_STATUS_DATA_READY_BIT 0
+#define UART_LINE_STATUS_OVERRUN_BIT    1
 #define UART_LINE_STATUS_THR_EMPTY_BIT  5
 #define UART_LINE_STATUS_TMIT_EMPTY_BIT 6
 
+#define UART_INTR_ENABLE_RDA_BIT  0 // received data available (and character timeout)
+#define UART_INTR_ENABLE_THRE_BIT 1 // transmitter holding register empty
+#define UART_INTR_ENABLE_RLS_BIT  2 // receiver line status
+#define UART_INTR_ENABLE_MS_BIT   3 // modem status
+
+#define UART_INTR_IDENT_NONE_BIT  0 // set if no interrupt is pending
+
+// Interrupt and transmit buffering
+#define UART_FIFO_DEPTH  16  // bytes in the hardware TX/RX FIFO
+#define UART_TX_BUF_SIZE 128 // bytes in the software TX ring buffer (power of two)
+#define UART_RX_BUF_SIZE 128 // bytes in the software RX ring buffer (power of two)
+
+// Writes are queued in a ring buffer in SRAM which is drained by the THR empty interrupt,
+// up to UART_FIFO_DEPTH bytes at a time. uart_init enables the UART and global interrupts.
+// Writes only block if the ring buffer is full, use uart_write_flush to wait for completion.
+// Received bytes are moved into an RX ring buffer by the data available and character timeout
+// interrupts, or into the blocks of the double-buffered block API while it is active.
+// With global interrupts disabled (e.g. inside another handler) the buffers are served by polling.
+
+typedef struct {
+    uint32_t received;   // bytes taken from the hardware FIFO
+    uint32_t dropped;    // bytes lost because the ring buffer or both blocks were full
+    uint32_t hw_overrun; // hardware FIFO overruns (bytes lost before software could read them)
+} uart_rx_stats_t;
+
 void uart_init();
 
 void uart_loopback_enable();
@@ -43,14 +69,37 @@ int uart_read_ready();
 
 void uart_write(uint8_t byte);
 
-void uart_write_str(void *src, uint32_t len);
+// queue up to len bytes without blocking, returns the number of bytes queued
+uint32_t uart_write_str(const void *src, uint32_t len);
 
+// wait until all queued bytes have been sent
 void uart_write_flush();
 
+// UART interrupt handler (transmit and receive), registered by uart_init
+void uart_irq_handler(uint32_t cause);
+
 uint8_t uart_read();
 
 void uart_read_str(void *dst, uint32_t len);
 
+// copy the receive statistics, optionally clearing them
+void uart_rx_get_stats(uart_rx_stats_t *stats, int clear);
+
+// receive into two alternating blocks of len bytes, bypassing the ring buffer
+void uart_rx_block_start(uint8_t *block0, uint8_t *block1, uint32_t len);
+
+// return to ring buffered reception, partially filled blocks are discarded
+void uart_rx_block_stop();
+
+// return the next completely received block or 0 if there is none yet
+uint8_t *uart_rx_block_poll();
+
+// wait for the next completely received block
+uint8_t *uart_rx_block_wait();
+
+// hand the block returned by poll/wait back so it can be refilled
+void uart_rx_block_release();
+
 void putchar(char byte);
 
 char getchar();
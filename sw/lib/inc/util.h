@@ -46,6 +46,33 @@ static inline void set_mie(int enable) {
         asm volatile("csrci mstatus, 8" ::: "memory");
 }
 
+// Enables or disables a single M-mode interrupt source (mie bit index equals its mcause).
+static inline void set_irq_enable(uint32_t cause, int enable) {
+    if (enable)
+        asm volatile("csrs mie, %0" ::"r"(1u << cause) : "memory");
+    else
+        asm volatile("csrc mie, %0" ::"r"(1u << cause) : "memory");
+}
+
+// Disables M-mode global interrupts and returns the previous state for irq_restore.
+static inline uint32_t irq_save() {
+    uint32_t mstatus;
+    asm volatile("csrrci %0, mstatus, 8" : "=r"(mstatus)::"memory");
+    return mstatus & 8;
+}
+
+// Restores the M-mode global interrupt state returned by irq_save.
+static inline void irq_restore(uint32_t state) {
+    if (state) asm volatile("csrsi mstatus, 8" ::: "memory");
+}
+
+// Returns non-zero if M-mode global interrupts are enabled.
+static inline int irq_enabled() {
+    uint32_t mstatus;
+    asm volatile("csrr %0, mstatus" : "=r"(mstatus)::"memory");
+    return mstatus & 8;
+}
+
 // Get cycle count since reset
 static inline uint64_t get_mcycle() {
     uint64_t mcycle;
@@ -53,6 +80,13 @@ static inline uint64_t get_mcycle() {
     return mcycle;
 }
 
+// Get number of retired instructions since reset
+static inline uint32_t get_minstret() {
+    uint32_t minstret;
+    asm volatile("csrr %0, minstret" : "=r"(minstret)::"memory");
+    return minstret;
+}
+
 // This may also be used to invoke code that does not return.
 static inline uint64_t invoke(void *code) {
     uint64_t (*code_fun_ptr)(void) = code;
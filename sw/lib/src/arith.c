@@ -0,0 +1,73 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "arith.h"
+
+uint32_t mul32(uint32_t a, uint32_t b) {
+    if (a < b) {
+        uint32_t t = a;
+        a = b;
+        b = t;
+    }
+    uint32_t r = 0;
+    while (b) {
+        if (b & 1) r += a;
+        if (b & 2) r += a << 1;
+        a <<= 2;
+        b >>= 2;
+    }
+    return r;
+}
+
+int32_t smul32(int32_t a, int32_t b) {
+    uint32_t r = mul32(a < 0 ? -(uint32_t)a : (uint32_t)a, b < 0 ? -(uint32_t)b : (uint32_t)b);
+    return (int32_t)((a ^ b) < 0 ? -r : r);
+}
+
+uint64_t mul64(uint32_t a, uint32_t b) {
+    uint32_t al = a & 0xFFFF, ah = a >> 16;
+    uint32_t bl = b & 0xFFFF, bh = b >> 16;
+    uint32_t ll = mul32(al, bl);
+    uint32_t lh = mul32(al, bh);
+    uint32_t hl = mul32(ah, bl);
+    uint32_t hh = mul32(ah, bh);
+    // middle terms: sum the halves separately to keep their carries
+    uint32_t mid = (ll >> 16) + (lh & 0xFFFF) + (hl & 0xFFFF);
+    uint32_t lo  = (ll & 0xFFFF) | (mid << 16);
+    uint32_t hi  = hh + (lh >> 16) + (hl >> 16) + (mid >> 16);
+    return ((uint64_t)hi << 32) | lo;
+}
+
+int64_t smul64(int32_t a, int32_t b) {
+    uint64_t r = mul64(a < 0 ? -(uint32_t)a : (uint32_t)a, b < 0 ? -(uint32_t)b : (uint32_t)b);
+    return (int64_t)((a ^ b) < 0 ? -r : r);
+}
+
+uint32_t udivmod32(uint32_t n, uint32_t d, uint32_t *rem) {
+    uint32_t q = 0;
+    if (d == 0) {
+        q = 0xFFFFFFFF;
+    } else if ((d & (d - 1)) == 0) {
+        q = n;
+        n &= d - 1;
+        while (d >>= 1) q >>= 1;
+    } else if (n >= d) {
+        // align the divisor with the leading bit of the dividend
+        uint32_t bit = 1;
+        while (!(d & 0x80000000) && (d << 1) <= n) {
+            d <<= 1;
+            bit <<= 1;
+        }
+        while (bit) {
+            if (n >= d) {
+                n -= d;
+                q |= bit;
+            }
+            d >>= 1;
+            bit >>= 1;
+        }
+    }
+    if (rem) *rem = n;
+    return q;
+}
@@ -0,0 +1,100 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bench.h"
+#include "uart.h"
+#include "print.h"
+#include "util.h"
+
+static void bench_empty(void *arg) {
+    (void)arg;
+}
+
+static const bench_t bench_overhead = {"overhead", 0, bench_empty, 0};
+
+/// @brief median of a small sample set, sorts the samples in place
+static uint32_t median(uint32_t *samples, uint32_t count) {
+    for (uint32_t i = 1; i < count; i++) {
+        uint32_t val = samples[i];
+        uint32_t j   = i;
+        while (j > 0 && samples[j - 1] > val) {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = val;
+    }
+    return samples[count / 2];
+}
+
+/// @brief run a kernel and return its raw (not overhead corrected) samples
+static void measure(const bench_t *bench, uint32_t warmup, uint32_t reps, uint32_t *cycles,
+                    uint32_t *instret) {
+    // drain pending output first, the THRE interrupt would otherwise hit the timed region
+    uart_write_flush();
+    uint32_t irq = irq_save();
+
+    for (uint32_t i = 0; i < warmup; i++) {
+        if (bench->setup) bench->setup(bench->arg);
+        bench->run(bench->arg);
+    }
+
+    for (uint32_t i = 0; i < reps; i++) {
+        if (bench->setup) bench->setup(bench->arg);
+        uint32_t c0 = get_mcycle();
+        uint32_t i0 = get_minstret();
+        bench->run(bench->arg);
+        uint32_t i1 = get_minstret();
+        uint32_t c1 = get_mcycle();
+        cycles[i]   = c1 - c0;
+        instret[i]  = i1 - i0;
+    }
+
+    irq_restore(irq);
+}
+
+void bench_run(const bench_t *bench, uint32_t warmup, uint32_t reps, bench_result_t *result) {
+    uint32_t cycles[BENCH_MAX_REPS];
+    uint32_t instret[BENCH_MAX_REPS];
+    uint32_t cycles_ovh, instret_ovh;
+
+    reps = (reps == 0) ? 1 : MIN(reps, BENCH_MAX_REPS);
+
+    // cost of the measurement itself (call through the function pointer and CSR reads)
+    measure(&bench_overhead, 1, 1, &cycles_ovh, &instret_ovh);
+    measure(bench, warmup, reps, cycles, instret);
+
+    result->reps           = reps;
+    result->cycles_median  = median(cycles, reps);
+    result->instret_median = median(instret, reps);
+    result->cycles_min     = cycles[0]; // sorted by median()
+    result->instret_min    = instret[0];
+
+    result->cycles_min     -= MIN(cycles_ovh, result->cycles_min);
+    result->cycles_median  -= MIN(cycles_ovh, result->cycles_median);
+    result->instret_min    -= MIN(instret_ovh, result->instret_min);
+    result->instret_median -= MIN(instret_ovh, result->instret_median);
+}
+
+uint32_t bench_cpi_x1000(uint32_t cycles, uint32_t instret) {
+    if (instret == 0) return 0;
+    // split the division to avoid overflowing cycles * 1000
+    return (cycles / instret) * 1000 + ((cycles % instret) * 1000) / instret;
+}
+
+void bench_report(const char *name, const bench_result_t *result) {
+    printf("BENCH,");
+    printf((char *)name);
+    printf(",%x,%x,%x,%x,%x,%x\n", result->reps, result->cycles_min, result->cycles_median,
+           result->instret_min, result->instret_median,
+           bench_cpi_x1000(result->cycles_median, result->instret_median));
+}
+
+void bench_run_all(const bench_t *benches, uint32_t count) {
+    bench_result_t result;
+    for (uint32_t i = 0; i < count; i++) {
+        bench_run(&benches[i], BENCH_WARMUP, BENCH_REPS, &result);
+        bench_report(benches[i].name, &result);
+    }
+    uart_write_flush();
+}
@@ -0,0 +1,30 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bitops.h"
+
+static const uint8_t popcount_nibble[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+uint32_t popcount8(uint8_t x) {
+    return popcount_nibble[x & 0xF] + popcount_nibble[x >> 4];
+}
+
+uint32_t popcount_words(const uint32_t *words, uint32_t count) {
+    uint32_t total = 0;
+    while (count) {
+        // every byte of acc holds at most 8 per word, 31 words still fit
+        uint32_t block = count < 31 ? count : 31;
+        uint32_t acc = 0;
+        count -= block;
+        while (block--) {
+            uint32_t x = *words++;
+            x = x - ((x >> 1) & 0x55555555);
+            x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+            acc += (x + (x >> 4)) & 0x0F0F0F0F;
+        }
+        acc = (acc & 0x00FF00FF) + ((acc >> 8) & 0x00FF00FF);
+        total += (acc & 0xFFFF) + (acc >> 16);
+    }
+    return total;
+}
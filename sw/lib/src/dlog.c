@@ -0,0 +1,33 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "dlog.h"
+#include "uart.h"
+#include "util.h"
+
+uint32_t dlog_begin(const char *fmt) {
+    uint32_t irq_state = irq_save();
+    uart_write(DLOG_SYNC);
+    // the format id is the offset of the string in .dlog_fmt, which starts at address 0
+    dlog_u32((uint32_t)(uintptr_t)fmt);
+    return irq_state;
+}
+
+void dlog_end(uint32_t irq_state) {
+    irq_restore(irq_state);
+}
+
+void dlog_u32(uint32_t value) {
+    while (value >= 0x80) {
+        uart_write((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    uart_write(value);
+}
+
+void dlog_str(const char *str) {
+    if (!str) str = "(null)";
+    while (*str) uart_write(*str++);
+    uart_write(0);
+}
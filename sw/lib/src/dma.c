@@ -0,0 +1,48 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "dma.h"
+#include "util.h"
+#include "config.h"
+
+void dma_start_strided(uintptr_t dst, int32_t dst_stride, uintptr_t src, int32_t src_stride,
+                       uint32_t len, int irq_enable) {
+    *reg32(USER_DMA_BASE_ADDR, DMA_SRC_REG_OFFSET)        = src;
+    *reg32(USER_DMA_BASE_ADDR, DMA_DST_REG_OFFSET)        = dst;
+    *reg32(USER_DMA_BASE_ADDR, DMA_LEN_REG_OFFSET)        = len;
+    *reg32(USER_DMA_BASE_ADDR, DMA_SRC_STRIDE_REG_OFFSET) = src_stride;
+    *reg32(USER_DMA_BASE_ADDR, DMA_DST_STRIDE_REG_OFFSET) = dst_stride;
+    // make sure the buffers are written before the DMA starts reading them
+    fence();
+    *reg32(USER_DMA_BASE_ADDR, DMA_CTRL_REG_OFFSET) =
+        (1 << DMA_CTRL_START_BIT) | ((irq_enable ? 1 : 0) << DMA_CTRL_IRQ_EN_BIT);
+}
+
+void dma_start(void *dst, const void *src, uint32_t len) {
+    dma_start_strided((uintptr_t)dst, 4, (uintptr_t)src, 4, len, 0);
+}
+
+int dma_busy(void) {
+    return *reg32(USER_DMA_BASE_ADDR, DMA_STATUS_REG_OFFSET) & (1 << DMA_STATUS_BUSY_BIT);
+}
+
+int dma_wait(void) {
+    uint32_t status;
+    do {
+        status = *reg32(USER_DMA_BASE_ADDR, DMA_STATUS_REG_OFFSET);
+    } while (status & (1 << DMA_STATUS_BUSY_BIT));
+    return (status & (1 << DMA_STATUS_ERROR_BIT)) ? -1 : 0;
+}
+
+void dma_clear(void) {
+    *reg32(USER_DMA_BASE_ADDR, DMA_STATUS_REG_OFFSET) =
+        (1 << DMA_STATUS_DONE_BIT) | (1 << DMA_STATUS_ERROR_BIT);
+}
+
+int dma_memcpy(void *dst, const void *src, uint32_t len) {
+    dma_start(dst, src, len);
+    int ret = dma_wait();
+    dma_clear();
+    return ret;
+}
@@ -0,0 +1,52 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "edge_detect.h"
+#include "util.h"
+#include "config.h"
+
+void edge_detect_init(uint32_t width, uint32_t height) {
+    *reg32(USER_EDGE_DETECT_BASE_ADDR, EDGE_DETECT_SOBEL_CFG_REG_OFFSET) =
+        (width << EDGE_DETECT_SOBEL_CFG_WIDTH_BIT) | (height << EDGE_DETECT_SOBEL_CFG_HEIGHT_BIT);
+}
+
+void edge_detect_push_row(const uint8_t *row, uint32_t width) {
+    const uint32_t *src = (const uint32_t *)row;
+    volatile uint32_t *pixels = reg32(USER_EDGE_DETECT_BASE_ADDR, EDGE_DETECT_SOBEL_PIXELS_REG_OFFSET);
+    for (uint32_t i = 0; i < width / 4; i++) {
+        *pixels = src[i];
+    }
+}
+
+void edge_detect_read_row(uint8_t *row, uint32_t width) {
+    uint32_t *dst = (uint32_t *)row;
+    volatile uint32_t *out = reg32(USER_EDGE_DETECT_BASE_ADDR, EDGE_DETECT_SOBEL_OUT_REG_OFFSET);
+    for (uint32_t i = 0; i < width / 4; i++) {
+        dst[i] = out[i];
+    }
+}
+
+void edge_detect_frame(const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t height) {
+    uint32_t *first = (uint32_t *)dst;
+    uint32_t *last  = (uint32_t *)(dst + (height - 1) * width);
+    // the top and bottom row have no complete neighbourhood
+    for (uint32_t i = 0; i < width / 4; i++) {
+        first[i] = 0;
+        last[i]  = 0;
+    }
+
+    edge_detect_init(width, height);
+    edge_detect_push_row(src, width);
+    src += width;
+    edge_detect_push_row(src, width);
+    src += width;
+    dst += width;
+    // each new row completes the neighbourhood of the row before it
+    for (uint32_t y = 2; y < height; y++) {
+        edge_detect_push_row(src, width);
+        edge_detect_read_row(dst, width);
+        src += width;
+        dst += width;
+    }
+}
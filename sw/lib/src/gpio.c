@@ -10,16 +10,16 @@
 #include "config.h"
 
 void gpio_set_direction(uint32_t mask, uint32_t direction) {
-    uint32_t dir_old = *reg32(GPIO_BASE_ADDR, GPIO_DIR_REG_OFFSET);
-    *reg32(GPIO_BASE_ADDR, GPIO_DIR_REG_OFFSET) = (dir_old & ~mask) | (direction & mask);
+    *reg32(GPIO_BASE_ADDR, GPIO_DIR_SET_REG_OFFSET) = direction & mask;
+    *reg32(GPIO_BASE_ADDR, GPIO_DIR_CLR_REG_OFFSET) = ~direction & mask;
 }
 
 void gpio_enable(uint32_t mask) {
-    *reg32(GPIO_BASE_ADDR, GPIO_EN_REG_OFFSET) |= mask;
+    *reg32(GPIO_BASE_ADDR, GPIO_EN_SET_REG_OFFSET) = mask;
 }
 
 void gpio_disable(uint32_t mask) {
-    *reg32(GPIO_BASE_ADDR, GPIO_EN_REG_OFFSET) &= ~mask;
+    *reg32(GPIO_BASE_ADDR, GPIO_EN_CLR_REG_OFFSET) = mask;
 }
 
 void gpio_write(uint32_t value) {
@@ -36,16 +36,16 @@ uint32_t gpio_read(void) {
 
 void gpio_enable_rising_interrupts(uint32_t mask) {
     *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EDGE_REG_OFFSET) |= mask;
-    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_REG_OFFSET) |= mask;
+    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_SET_REG_OFFSET) = mask;
 }
 
 void gpio_enable_falling_interrupts(uint32_t mask) {
     *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EDGE_REG_OFFSET) &= ~mask;
-    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_REG_OFFSET) |= mask;
+    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_SET_REG_OFFSET) = mask;
 }
 
 void gpio_disable_interrupts(uint32_t mask) {
-    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_REG_OFFSET) &= ~mask;
+    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_CLR_REG_OFFSET) = mask;
 }
 
 uint32_t gpio_get_interrupt_status(void) {
@@ -53,23 +53,23 @@ uint32_t gpio_get_interrupt_status(void) {
 }
 
 void gpio_pin_set_output(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_DIR_REG_OFFSET) |= (1 << gpio_pin);
+    *reg32(GPIO_BASE_ADDR, GPIO_DIR_SET_REG_OFFSET) = (1 << gpio_pin);
 }
 
 void gpio_pin_enable(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_EN_REG_OFFSET) |= (1 << gpio_pin);
+    *reg32(GPIO_BASE_ADDR, GPIO_EN_SET_REG_OFFSET) = (1 << gpio_pin);
 }
 
 void gpio_pin_disable(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_EN_REG_OFFSET) &= ~(1 << gpio_pin);
+    *reg32(GPIO_BASE_ADDR, GPIO_EN_CLR_REG_OFFSET) = (1 << gpio_pin);
 }
 
 void gpio_pin_set(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_OUT_REG_OFFSET) |= (1 << gpio_pin);
+    *reg32(GPIO_BASE_ADDR, GPIO_OUT_SET_REG_OFFSET) = (1 << gpio_pin);
 }
 
 void gpio_pin_clear(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_OUT_REG_OFFSET) &= ~(1 << gpio_pin);
+    *reg32(GPIO_BASE_ADDR, GPIO_OUT_CLR_REG_OFFSET) = (1 << gpio_pin);
 }
 
 void gpio_pin_toggle(uint8_t gpio_pin) {
@@ -82,18 +82,50 @@ uint8_t gpio_pin_read(uint8_t gpio_pin) {
 
 void gpio_pin_enable_rising_interrupt(uint8_t gpio_pin) {
     *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EDGE_REG_OFFSET) |= (1 << gpio_pin);
-    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_REG_OFFSET) |= (1 << gpio_pin);
+    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_SET_REG_OFFSET) = (1 << gpio_pin);
 }
 
 void gpio_pin_enable_falling_interrupt(uint8_t gpio_pin) {
     *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EDGE_REG_OFFSET) &= ~(1 << gpio_pin);
-    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_REG_OFFSET) |= (1 << gpio_pin);
+    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_SET_REG_OFFSET) = (1 << gpio_pin);
 }
 
 void gpio_pin_disable_interrupts(uint8_t gpio_pin) {
-    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_REG_OFFSET) &= ~(1 << gpio_pin);
+    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_CLR_REG_OFFSET) = (1 << gpio_pin);
 }
 
 uint8_t gpio_pin_get_interrupt_status(uint8_t gpio_pin) {
     return (*reg32(GPIO_BASE_ADDR, GPIO_INTRPT_STATUS_REG_OFFSET) >> gpio_pin) & 1;
 }
+
+void gpio_wave_config(uint32_t period, uint32_t mask) {
+    *reg32(GPIO_BASE_ADDR, GPIO_WAVE_MASK_REG_OFFSET) = mask;
+    *reg32(GPIO_BASE_ADDR, GPIO_WAVE_CFG_REG_OFFSET) =
+        (period & GPIO_WAVE_CFG_PERIOD_MASK) | (1 << GPIO_WAVE_CFG_ENABLE_BIT);
+}
+
+void gpio_wave_disable(void) {
+    *reg32(GPIO_BASE_ADDR, GPIO_WAVE_CFG_REG_OFFSET) = 0;
+}
+
+uint32_t gpio_wave_push(uint32_t pattern) {
+    if ((*reg32(GPIO_BASE_ADDR, GPIO_WAVE_STATUS_REG_OFFSET) >> GPIO_WAVE_STATUS_FULL_BIT) & 1) {
+        return 0;
+    }
+    *reg32(GPIO_BASE_ADDR, GPIO_WAVE_DATA_REG_OFFSET) = pattern;
+    return 1;
+}
+
+uint32_t gpio_wave_level(void) {
+    return *reg32(GPIO_BASE_ADDR, GPIO_WAVE_STATUS_REG_OFFSET) & GPIO_WAVE_STATUS_LEVEL_MASK;
+}
+
+void gpio_wave_write(const uint32_t *patterns, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) {
+        while (!gpio_wave_push(patterns[i]));
+    }
+}
+
+void gpio_wave_flush(void) {
+    while (!((*reg32(GPIO_BASE_ADDR, GPIO_WAVE_STATUS_REG_OFFSET) >> GPIO_WAVE_STATUS_EMPTY_BIT) & 1));
+}
@@ -0,0 +1,46 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "irq.h"
+#include "soc_ctrl.h"
+#include "util.h"
+#include "config.h"
+
+// An enabled source without a handler would trap again right away, mask it instead
+static void irq_default_handler(uint32_t cause) {
+    set_irq_enable(cause, 0);
+}
+
+static uint32_t exception_default_handler(uint32_t mcause, uint32_t mepc, uint32_t mtval) {
+    (void)mtval;
+    // end of code with the cause as exit code (bit 31 tells it apart from a return value)
+    *reg32(SOCCTRL_BASE_ADDR, SOC_CTRL_CORESTATUS_REG_OFFSET) = 0x80000000 | mcause;
+    while (1) wfi();
+    return mepc;
+}
+
+irq_handler_t irq_handlers[IRQ_NUM] = {
+    [0 ... IRQ_NUM - 1] = irq_default_handler
+};
+
+static exception_handler_t exception_handler = exception_default_handler;
+
+void irq_register(uint32_t cause, irq_handler_t handler) {
+    irq_handlers[cause] = handler;
+    set_irq_enable(cause, 1);
+}
+
+void irq_unregister(uint32_t cause) {
+    set_irq_enable(cause, 0);
+    irq_handlers[cause] = irq_default_handler;
+}
+
+void exception_register(exception_handler_t handler) {
+    exception_handler = handler ? handler : exception_default_handler;
+}
+
+// called from the vector table in crt0.S
+uint32_t __exception_dispatch(uint32_t mcause, uint32_t mepc, uint32_t mtval) {
+    return exception_handler(mcause, mepc, mtval);
+}
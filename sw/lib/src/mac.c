@@ -0,0 +1,50 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mac.h"
+#include "util.h"
+#include "config.h"
+
+uint64_t mac_acc64(void) {
+    uint32_t lo = *reg32(USER_MAC_BASE_ADDR, MAC_ACC_LO_REG_OFFSET);
+    uint32_t hi = *reg32(USER_MAC_BASE_ADDR, MAC_ACC_HI_REG_OFFSET);
+    return ((uint64_t)hi << 32) | lo;
+}
+
+uint64_t mac_mul64(uint32_t a, uint32_t b) {
+    *reg32(USER_MAC_BASE_ADDR, MAC_A_REG_OFFSET) = a;
+    *reg32(USER_MAC_BASE_ADDR, MAC_B_REG_OFFSET) = b;
+    uint32_t lo = *reg32(USER_MAC_BASE_ADDR, MAC_PROD_LO_REG_OFFSET);
+    uint32_t hi = *reg32(USER_MAC_BASE_ADDR, MAC_PROD_HI_REG_OFFSET);
+    return ((uint64_t)hi << 32) | lo;
+}
+
+void mac_load_coefs(const uint32_t *coefs, uint32_t n) {
+    volatile uint32_t *coef = reg32(USER_MAC_BASE_ADDR, MAC_COEF_REG_OFFSET);
+    for (uint32_t i = 0; i < n && i < MAC_COEF_WORDS; i++) coef[i] = coefs[i];
+}
+
+void mac_stream(const uint32_t *data, uint32_t n) {
+    volatile uint32_t *port = reg32(USER_MAC_BASE_ADDR, MAC_DATA_REG_OFFSET);
+    // consecutive addresses of the data window, unrolled by four
+    while (n >= 4) {
+        port[0] = data[0];
+        port[1] = data[1];
+        port[2] = data[2];
+        port[3] = data[3];
+        data += 4;
+        n -= 4;
+    }
+    while (n--) *port = *data++;
+}
+
+int32_t mac_dot(const uint32_t *a, const uint32_t *b, uint32_t n) {
+    volatile uint32_t *base = reg32(USER_MAC_BASE_ADDR, 0);
+    base[MAC_ACC_LO_REG_OFFSET / 4] = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        base[MAC_A_REG_OFFSET / 4]   = a[i];
+        base[MAC_MAC_REG_OFFSET / 4] = b[i];
+    }
+    return base[MAC_RESULT_REG_OFFSET / 4];
+}
@@ -0,0 +1,90 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mem.h"
+
+// keep GCC from turning the loops below back into calls of themselves
+#define MEM_KERNEL __attribute__((optimize("no-tree-loop-distribute-patterns")))
+
+// word accesses to buffers of any type
+typedef uint32_t __attribute__((may_alias)) word_t;
+
+MEM_KERNEL void *memcpy(void *dst, const void *src, size_t n) {
+    uint8_t *d = dst;
+    const uint8_t *s = src;
+
+    if ((((uintptr_t)d ^ (uintptr_t)s) & 3) == 0) {
+        while (((uintptr_t)d & 3) && n) {
+            *d++ = *s++;
+            n--;
+        }
+        word_t *dw = (word_t *)d;
+        const word_t *sw = (const word_t *)s;
+        for (; n >= 16; n -= 16) {
+            uint32_t w0 = sw[0], w1 = sw[1], w2 = sw[2], w3 = sw[3];
+            dw[0] = w0;
+            dw[1] = w1;
+            dw[2] = w2;
+            dw[3] = w3;
+            dw += 4;
+            sw += 4;
+        }
+        for (; n >= 4; n -= 4) *dw++ = *sw++;
+        d = (uint8_t *)dw;
+        s = (const uint8_t *)sw;
+    }
+    while (n--) *d++ = *s++;
+    return dst;
+}
+
+MEM_KERNEL void *memset(void *dst, int c, size_t n) {
+    uint8_t *d = dst;
+    uint32_t pattern = (uint8_t)c;
+    pattern |= pattern << 8;
+    pattern |= pattern << 16;
+
+    while (((uintptr_t)d & 3) && n) {
+        *d++ = (uint8_t)c;
+        n--;
+    }
+    word_t *dw = (word_t *)d;
+    for (; n >= 16; n -= 16) {
+        dw[0] = pattern;
+        dw[1] = pattern;
+        dw[2] = pattern;
+        dw[3] = pattern;
+        dw += 4;
+    }
+    for (; n >= 4; n -= 4) *dw++ = pattern;
+    d = (uint8_t *)dw;
+    while (n--) *d++ = (uint8_t)c;
+    return dst;
+}
+
+MEM_KERNEL int memcmp(const void *a, const void *b, size_t n) {
+    const uint8_t *pa = a;
+    const uint8_t *pb = b;
+
+    if ((((uintptr_t)pa ^ (uintptr_t)pb) & 3) == 0) {
+        while (((uintptr_t)pa & 3) && n) {
+            if (*pa != *pb) return *pa - *pb;
+            pa++;
+            pb++;
+            n--;
+        }
+        // skip equal words, the first difference is then found byte by byte
+        const word_t *wa = (const word_t *)pa;
+        const word_t *wb = (const word_t *)pb;
+        for (; n >= 4 && *wa == *wb; n -= 4) {
+            wa++;
+            wb++;
+        }
+        pa = (const uint8_t *)wa;
+        pb = (const uint8_t *)wb;
+    }
+    for (; n; n--, pa++, pb++) {
+        if (*pa != *pb) return *pa - *pb;
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "perf.h"
+#include "print.h"
+#include "util.h"
+#include "config.h"
+
+static const char *const perf_mgr_names[PERF_NUM_MGR] = {"user", "debug", "data", "instr"};
+
+// every CTRL write also sets the enable bit
+static inline void perf_ctrl(uint32_t val) {
+    *reg32(PERF_BASE_ADDR, PERF_CTRL_REG_OFFSET) = val;
+}
+
+void perf_start(void) {
+    perf_ctrl((1 << PERF_CTRL_ENABLE_BIT) | (1 << PERF_CTRL_CLEAR_BIT));
+}
+
+void perf_stop(void) {
+    perf_ctrl(0);
+}
+
+void perf_read(perf_counters_t *counters) {
+    uint32_t enable = *reg32(PERF_BASE_ADDR, PERF_CTRL_REG_OFFSET);
+    perf_ctrl((1 << PERF_CTRL_SNAPSHOT_BIT) | enable);
+
+    counters->cycles = *reg32(PERF_BASE_ADDR, PERF_CYCLES_REG_OFFSET);
+    for (uint32_t e = 0; e < PERF_NUM_EVENTS; e++) {
+        counters->events[e] = *reg32(PERF_BASE_ADDR, PERF_EVENT_REG_OFFSET(e));
+    }
+    for (uint32_t m = 0; m < PERF_NUM_MGR; m++) {
+        uint32_t base   = PERF_BASE_ADDR + PERF_MGR_REG_OFFSET(m);
+        perf_mgr_t *mgr = &counters->mgr[m];
+        mgr->req        = *reg32(base, PERF_REQ_REG_OFFSET);
+        mgr->wait       = *reg32(base, PERF_WAIT_REG_OFFSET);
+        mgr->lat        = *reg32(base, PERF_LAT_REG_OFFSET);
+        for (uint32_t s = 0; s < PERF_NUM_SBR; s++) {
+            mgr->sbr[s] = *reg32(base, PERF_SBR_REG_OFFSET(s));
+        }
+    }
+}
+
+void perf_begin(perf_counters_t *start) {
+    if (!*reg32(PERF_BASE_ADDR, PERF_CTRL_REG_OFFSET)) perf_start();
+    perf_read(start);
+}
+
+void perf_end(const perf_counters_t *start, perf_counters_t *delta) {
+    perf_read(delta);
+    // all fields are uint32_t counters, wrap-safe differences
+    const uint32_t *from = (const uint32_t *)start;
+    uint32_t *to         = (uint32_t *)delta;
+    for (uint32_t i = 0; i < sizeof(perf_counters_t) / sizeof(uint32_t); i++) {
+        to[i] -= from[i];
+    }
+}
+
+void perf_report(const char *name, const perf_counters_t *counters) {
+    printf("PERF,");
+    printf((char *)name);
+    printf(",cycles,%x\n", counters->cycles);
+    printf("PERF,");
+    printf((char *)name);
+    printf(",loop_cache,%x,%x\n", counters->events[PERF_EVENT_LOOP_CACHE_HIT],
+           counters->events[PERF_EVENT_LOOP_CACHE_MISS]);
+    for (uint32_t m = 0; m < PERF_NUM_MGR; m++) {
+        const perf_mgr_t *mgr = &counters->mgr[m];
+        printf("PERF,");
+        printf((char *)name);
+        printf(",");
+        printf((char *)perf_mgr_names[m]);
+        printf(",%x,%x,%x", mgr->req, mgr->wait, mgr->lat);
+        for (uint32_t s = 0; s < PERF_NUM_SBR; s++) printf(",%x", mgr->sbr[s]);
+        printf("\n");
+    }
+}
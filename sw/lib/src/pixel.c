@@ -0,0 +1,50 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "pixel.h"
+
+#define PX_BINARY_OP(name, op4, op1)                                                    \
+    void name(uint8_t *dst, const uint8_t *a, const uint8_t *b, uint32_t count) {       \
+        uint32_t *d = (uint32_t *)dst;                                                  \
+        const uint32_t *wa = (const uint32_t *)a;                                       \
+        const uint32_t *wb = (const uint32_t *)b;                                       \
+        for (uint32_t i = 0; i < count / 4; i++) d[i] = op4(wa[i], wb[i]);              \
+        for (uint32_t i = count & ~3u; i < count; i++) dst[i] = op1(a[i], b[i]);        \
+    }
+
+#define PX_ADD1(x, y)     px_sat((int32_t)(x) + (y))
+#define PX_SUB1(x, y)     px_sat((int32_t)(x) - (y))
+#define PX_ABSDIFF1(x, y) ((x) > (y) ? (x) - (y) : (y) - (x))
+
+PX_BINARY_OP(px_add_sat, px4_add_sat, PX_ADD1)
+PX_BINARY_OP(px_sub_sat, px4_sub_sat, PX_SUB1)
+PX_BINARY_OP(px_absdiff, px4_absdiff, PX_ABSDIFF1)
+
+void px_scale(uint8_t *dst, const uint8_t *src, uint8_t gain, uint32_t count) {
+    // shift-add over the (at most 8) bits of the gain, without __mulsi3 per pixel
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t p = src[i], g = gain, acc = 0;
+        for (; g; g >>= 1, p <<= 1) {
+            if (g & 1) acc += p;
+        }
+        acc >>= 4;
+        dst[i] = acc > 255 ? 255 : (uint8_t)acc;
+    }
+}
+
+void px_threshold(uint8_t *dst, const uint8_t *src, uint8_t threshold, uint32_t count) {
+    // per byte: src + (256 - threshold) carries into bit 8 iff src >= threshold,
+    // the bytes are split into even and odd ones to keep room for the carries
+    uint32_t add = 256 - threshold;
+    add |= add << 16;
+    uint32_t *d = (uint32_t *)dst;
+    const uint32_t *s = (const uint32_t *)src;
+    for (uint32_t i = 0; i < count / 4; i++) {
+        uint32_t even = ((s[i] & 0x00FF00FF) + add) & 0x01000100;
+        uint32_t odd  = (((s[i] >> 8) & 0x00FF00FF) + add) & 0x01000100;
+        uint32_t msbs = (even >> 1) | (odd << 7); // bit 8 to bit 7, 15 for odd bytes
+        d[i] = px4_mask(msbs);
+    }
+    for (uint32_t i = count & ~3u; i < count; i++) dst[i] = src[i] >= threshold ? 255 : 0;
+}
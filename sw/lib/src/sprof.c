@@ -0,0 +1,73 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sprof.h"
+#include "timer.h"
+#include "irq.h"
+#include "uart.h"
+#include "print.h"
+#include "config.h"
+
+static soft_timer_t sprof_timer;
+static uint16_t sprof_hist[SPROF_BUCKETS]; // saturating counts
+static uint32_t sprof_samples;
+static uint32_t sprof_outside; // samples outside of the SRAM (e.g. user domain ROM)
+static uint32_t sprof_period;
+static uint32_t sprof_mode;
+static uint32_t sprof_begin, sprof_end; // timebase at sprof_start/sprof_stop
+static uint8_t sprof_running;
+
+// runs from the timer interrupt, the trap frame holds the interrupted registers
+static void sprof_sample(void *arg) {
+    (void)arg;
+    // a deadline missed with interrupts disabled runs from soft_timer_start/stop instead,
+    // there is no trap frame then; the sample is lost and shows up as expected > samples
+    if (!soft_timer_in_irq()) return;
+    const uint32_t *frame = irq_frame();
+    uint32_t addr = frame[sprof_mode == SPROF_MODE_RA ? IRQ_FRAME_RA : IRQ_FRAME_MEPC];
+    uint32_t offs = addr - SPROF_BASE;
+
+    sprof_samples++;
+    if (offs >= SPROF_SIZE) {
+        sprof_outside++;
+        return;
+    }
+    uint16_t *bucket = &sprof_hist[offs >> SPROF_BUCKET_SHIFT];
+    if (*bucket != 0xFFFF) (*bucket)++;
+}
+
+void sprof_start(uint32_t period_us, uint32_t mode) {
+    sprof_stop();
+    for (uint32_t i = 0; i < SPROF_BUCKETS; i++) sprof_hist[i] = 0;
+    sprof_samples = 0;
+    sprof_outside = 0;
+    sprof_mode    = mode;
+    sprof_period  = period_us;
+    sprof_begin   = timer_now();
+    sprof_running = 1;
+    soft_timer_start(&sprof_timer, period_us, period_us, sprof_sample, 0);
+}
+
+void sprof_stop(void) {
+    soft_timer_stop(&sprof_timer);
+    if (sprof_running) sprof_end = timer_now();
+    sprof_running = 0;
+}
+
+void sprof_dump(void) {
+    uint32_t period_cycles = sprof_period * TIMER_CYCLES_PER_US;
+    uint32_t elapsed       = (sprof_running ? timer_now() : sprof_end) - sprof_begin;
+    uint32_t expected      = period_cycles ? elapsed / period_cycles : 0;
+
+    printf("SPROF_BEGIN,");
+    printf(sprof_mode == SPROF_MODE_RA ? "ra" : "pc");
+    printf(",%x,%x,%x,%x,%x,%x\n", SPROF_BASE, SPROF_BUCKET_BYTES,
+           period_cycles, sprof_samples, expected, sprof_outside);
+    for (uint32_t i = 0; i < SPROF_BUCKETS; i++) {
+        if (sprof_hist[i] == 0) continue;
+        printf("SPROF,%x,%x\n", SPROF_BASE + (i << SPROF_BUCKET_SHIFT), sprof_hist[i]);
+    }
+    printf("SPROF_END\n");
+    uart_write_flush();
+}
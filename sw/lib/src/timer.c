@@ -5,34 +5,150 @@
 // Philippe Sauter <phsauter@iis.ee.ethz.ch>
 
 #include "timer.h"
+#include "irq.h"
 #include "util.h"
 #include "config.h"
 
-void sleep_ms(uint32_t ms) {
-    uint32_t config = \
-        (1 << CFG_LOW_REG_CLOCK_SOURCE_BIT) | // from 32.768 kHz ref clock
-        (1 << CFG_LOW_REG_PRESC_ENABLE_BIT) | // enable prescaler
-        (31 << CFG_LOW_REG_PRESC_VALUE_BIT) | // prescaler value
-        (1 << CFG_LOW_REG_CMP_CLR_BIT)      | // auto-clear
-        (1 << CFG_LOW_REG_IRQ_ENABLE_BIT)   | // enable IRQ
-        (1 << CFG_LOW_REG_ENABLE_BIT);        // enable timer
-
-    // disable timer
+static soft_timer_t *timer_queue; // pending timers, earliest deadline first
+static uint8_t timer_running;
+static uint8_t timer_in_service; // timer_service is running, it re-arms the alarm at its end
+static uint8_t timer_in_irq;
+
+// wrap-safe "a is before or at b" for timebase values
+static inline int timer_before_eq(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) <= 0;
+}
+
+static void timer_alarm_stop(void) {
+    *reg32(TIMER_BASE_ADDR, CFG_HIGH_REG_OFFSET) = 0;
+}
+
+static void timer_alarm_start(uint32_t cycles) {
+    *reg32(TIMER_BASE_ADDR, TIMER_RESET_HIGH_REG_OFFSET) = 1;
+    *reg32(TIMER_BASE_ADDR, TIMER_CMP_HIGH_REG_OFFSET)   = cycles;
+    *reg32(TIMER_BASE_ADDR, CFG_HIGH_REG_OFFSET) =
+        (1 << CFG_HIGH_REG_CMP_CLR_BIT)    | // repeat, a lost interrupt pulse comes again
+        (1 << CFG_HIGH_REG_IRQ_ENABLE_BIT) | // enable IRQ
+        (1 << CFG_HIGH_REG_ENABLE_BIT);      // enable timer (system clock, no prescaler)
+}
+
+static void timer_queue_insert(soft_timer_t *timer) {
+    soft_timer_t **pos = &timer_queue;
+    while (*pos && timer_before_eq((*pos)->deadline, timer->deadline)) {
+        pos = &(*pos)->next;
+    }
+    timer->next = *pos;
+    *pos = timer;
+    timer->active = 1;
+}
+
+static void timer_queue_remove(soft_timer_t *timer) {
+    for (soft_timer_t **pos = &timer_queue; *pos; pos = &(*pos)->next) {
+        if (*pos == timer) {
+            *pos = timer->next;
+            break;
+        }
+    }
+    timer->active = 0;
+}
+
+static void timer_run_due(void) {
+    while (timer_queue && timer_before_eq(timer_queue->deadline, timer_now())) {
+        soft_timer_t *timer = timer_queue;
+        timer_queue = timer->next;
+        timer->active = 0;
+        // requeue before the callback so it may stop or restart its own timer
+        if (timer->period) {
+            timer->deadline += timer->period;
+            timer_queue_insert(timer);
+        }
+        timer->callback(timer->arg);
+    }
+}
+
+// Runs the due timers and arms the alarm for the next deadline, call with interrupts disabled.
+// Nothing latches the alarm pulse, so a deadline is only left to the alarm once it is armed
+// and still at least TIMER_ALARM_MARGIN cycles ahead, closer ones are waited for and run here.
+static void timer_service(void) {
+    timer_in_service = 1;
+    timer_alarm_stop();
+    while (timer_queue) {
+        timer_run_due();
+        if (!timer_queue) break;
+
+        int32_t delta = (int32_t)(timer_queue->deadline - timer_now());
+        if (delta > TIMER_ALARM_MARGIN) {
+            timer_alarm_start(delta > TIMER_ALARM_MAX_CYCLES ? TIMER_ALARM_MAX_CYCLES : delta);
+            // programming the alarm takes a few bus accesses, check it is still in time
+            if ((int32_t)(timer_queue->deadline - timer_now()) > TIMER_ALARM_MARGIN / 2) break;
+            timer_alarm_stop();
+        }
+        while (!timer_before_eq(timer_queue->deadline, timer_now()))
+            ;
+    }
+    timer_in_service = 0;
+}
+
+static void timer_irq_handler(uint32_t cause) {
+    (void)cause;
+    timer_in_irq = 1;
+    timer_service();
+    timer_in_irq = 0;
+}
+
+void timer_init(void) {
+    // free-running timebase on the system clock
     *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) = 0;
+    *reg32(TIMER_BASE_ADDR, TIMER_RESET_LOW_REG_OFFSET) = 1;
+    *reg32(TIMER_BASE_ADDR, TIMER_CMP_LOW_REG_OFFSET) = 0xFFFFFFFF;
+    *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) = (1 << CFG_LOW_REG_ENABLE_BIT);
+
+    timer_alarm_stop();
+    timer_queue   = 0;
+    timer_running = 1;
+    irq_register(IRQ_TIMER_HI, timer_irq_handler);
+    set_mie(1);
+}
+
+uint32_t timer_now(void) {
+    return *reg32(TIMER_BASE_ADDR, TIMER_VALUE_LOW_REG_OFFSET);
+}
 
-    *reg32(TIMER_BASE_ADDR, TIMER_CMP_LOW_REG_OFFSET) = ms;
+void soft_timer_start(soft_timer_t *timer, uint32_t delay_us, uint32_t period_us,
+                      soft_timer_callback_t callback, void *arg) {
+    if (!timer_running) timer_init();
 
-    set_mtie(1);  // Machine Timer Interrupt Enable
-    set_mie(1);  // Global Interrupt Enable
+    uint32_t irq = irq_save();
+    if (timer->active) timer_queue_remove(timer);
+    timer->callback = callback;
+    timer->arg      = arg;
+    timer->period   = period_us * TIMER_CYCLES_PER_US;
+    timer->deadline = timer_now() + delay_us * TIMER_CYCLES_PER_US;
+    timer_queue_insert(timer);
+    // also runs deadlines missed while interrupts were disabled
+    if (!timer_in_service) timer_service();
+    irq_restore(irq);
+}
 
-    // start timer
-    *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) = config;
+void soft_timer_stop(soft_timer_t *timer) {
+    uint32_t irq = irq_save();
+    if (timer->active) timer_queue_remove(timer);
+    if (!timer_in_service) timer_service();
+    irq_restore(irq);
+}
 
-    asm volatile("wfi");
+int soft_timer_in_irq(void) {
+    return timer_in_irq;
+}
 
-    // turn off timer
-    *reg32(TIMER_BASE_ADDR, CFG_LOW_REG_OFFSET) &= ~(1 << CFG_LOW_REG_ENABLE_BIT);
+void sleep_us(uint32_t us) {
+    if (!timer_running) timer_init();
 
-    // disable timer interrupt
-    set_mtie(0);
+    uint32_t deadline = timer_now() + us * TIMER_CYCLES_PER_US;
+    while (!timer_before_eq(deadline, timer_now()))
+        ;
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us(ms * 1000);
 }
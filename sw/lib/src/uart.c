@@ -6,10 +6,34 @@
 // Paul Scheffler <paulsc@iis.ee.ethz.ch>
 
 #include "uart.h"
+#include "irq.h"
 #include "util.h"
 #include "config.h"
 
 #define UART_DIVISOR(freq, baud) ((freq) / ((baud) << 4))  // Divisor calculation
+#define UART_TX_BUF_MASK (UART_TX_BUF_SIZE - 1)
+#define UART_RX_BUF_MASK (UART_RX_BUF_SIZE - 1)
+
+// TX ring buffer, head is only written by producers and tail only by the drain
+static volatile uint8_t  tx_buf[UART_TX_BUF_SIZE];
+static volatile uint32_t tx_head;
+static volatile uint32_t tx_tail;
+static volatile uint8_t  uart_ier; // shadow of the interrupt enable register
+
+// RX ring buffer, head is only written by the fill and tail only by consumers
+static volatile uint8_t  rx_buf[UART_RX_BUF_SIZE];
+static volatile uint32_t rx_head;
+static volatile uint32_t rx_tail;
+static volatile uart_rx_stats_t rx_stats;
+
+// RX double buffer, a block is owned by the application from completion until release
+static uint8_t *volatile rx_blk[2];
+static volatile uint32_t rx_blk_len;
+static volatile uint32_t rx_blk_pos;   // next byte in the block being filled
+static volatile uint8_t  rx_blk_fill;  // block being filled
+static volatile uint8_t  rx_blk_next;  // next block handed to the application
+static volatile uint8_t  rx_blk_done[2];
+static volatile uint8_t  rx_blk_active;
 
 void uart_init() {
     const uint16_t divisor = UART_DIVISOR(UART_FREQ, UART_BAUD); // Calculate from provided config
@@ -22,6 +46,15 @@ void uart_init() {
     *reg8(UART_BASE_ADDR, UART_LINE_CONTROL_REG_OFFSET)  = 0x03; // 8 bits, no parity, one stop bit
     *reg8(UART_BASE_ADDR, UART_FIFO_CONTROL_REG_OFFSET)  = 0xC7; // Enable & clear FIFO, 14B threshold
     *reg8(UART_BASE_ADDR, UART_MODEM_CONTROL_REG_OFFSET) = 0x20; // Autoflow mode
+    tx_head  = 0;
+    tx_tail  = 0;
+    rx_head  = 0;
+    rx_tail  = 0;
+    rx_blk_active = 0;
+    uart_ier = (1 << UART_INTR_ENABLE_RDA_BIT);
+    *reg8(UART_BASE_ADDR, UART_INTR_ENABLE_REG_OFFSET) = uart_ier;
+    irq_register(IRQ_UART, uart_irq_handler);
+    set_mie(1);
 }
 
 void uart_loopback_enable() {
@@ -37,7 +70,8 @@ void uart_loopback_disable() {
 }
 
 int uart_read_ready() {
-    return *reg8(UART_BASE_ADDR, UART_LINE_STATUS_REG_OFFSET) & (1 << UART_LINE_STATUS_DATA_READY_BIT);
+    return (rx_head != rx_tail) ||
+           (*reg8(UART_BASE_ADDR, UART_LINE_STATUS_REG_OFFSET) & (1 << UART_LINE_STATUS_DATA_READY_BIT));
 }
 
 static inline int __uart_write_ready() {
@@ -49,31 +83,186 @@ static inline int __uart_write_idle() {
            *reg8(UART_BASE_ADDR, UART_LINE_STATUS_REG_OFFSET) & (1 << UART_LINE_STATUS_TMIT_EMPTY_BIT);
 }
 
+// Refill the (empty) hardware FIFO from the ring buffer, call with interrupts disabled.
+// Disables the THR empty interrupt once the ring buffer is drained.
+static void __uart_tx_fill() {
+    uint32_t tail = tx_tail;
+    for (uint32_t i = 0; i < UART_FIFO_DEPTH && tail != tx_head; ++i) {
+        *reg8(UART_BASE_ADDR, UART_THR_REG_OFFSET) = tx_buf[tail & UART_TX_BUF_MASK];
+        tail++;
+    }
+    tx_tail = tail;
+
+    uint8_t ier = (tail == tx_head) ? (uart_ier & ~(1 << UART_INTR_ENABLE_THRE_BIT))
+                                    : (uart_ier | (1 << UART_INTR_ENABLE_THRE_BIT));
+    if (ier != uart_ier) {
+        uart_ier = ier;
+        *reg8(UART_BASE_ADDR, UART_INTR_ENABLE_REG_OFFSET) = ier;
+    }
+}
+
+// Make progress on the ring buffer without relying on the interrupt
+static void __uart_tx_poll() {
+    if (__uart_write_ready()) {
+        uint32_t irq = irq_save();
+        __uart_tx_fill();
+        irq_restore(irq);
+    }
+}
+
+// Arm the THR empty interrupt, it fires right away if the FIFO is already empty
+static inline void __uart_tx_kick() {
+    if (!(uart_ier & (1 << UART_INTR_ENABLE_THRE_BIT))) {
+        uint32_t irq = irq_save();
+        uart_ier |= (1 << UART_INTR_ENABLE_THRE_BIT);
+        *reg8(UART_BASE_ADDR, UART_INTR_ENABLE_REG_OFFSET) = uart_ier;
+        irq_restore(irq);
+    }
+}
+
+// Store a received byte in the active block or the ring buffer
+static inline void __uart_rx_store(uint8_t byte) {
+    rx_stats.received++;
+    if (rx_blk_active) {
+        uint32_t fill = rx_blk_fill;
+        if (rx_blk_done[fill]) { // both blocks are held by the application
+            rx_stats.dropped++;
+            return;
+        }
+        uint32_t pos = rx_blk_pos;
+        rx_blk[fill][pos++] = byte;
+        if (pos == rx_blk_len) {
+            rx_blk_done[fill] = 1;
+            rx_blk_fill = fill ^ 1;
+            pos = 0;
+        }
+        rx_blk_pos = pos;
+    } else if (rx_head - rx_tail >= UART_RX_BUF_SIZE) {
+        rx_stats.dropped++;
+    } else {
+        rx_buf[rx_head & UART_RX_BUF_MASK] = byte;
+        rx_head++;
+    }
+}
+
+// Empty the hardware RX FIFO, call with interrupts disabled.
+// Reading RBR also clears the data available and character timeout interrupts.
+static void __uart_rx_drain() {
+    uint8_t lsr;
+    while ((lsr = *reg8(UART_BASE_ADDR, UART_LINE_STATUS_REG_OFFSET)) &
+           (1 << UART_LINE_STATUS_DATA_READY_BIT)) {
+        if (lsr & (1 << UART_LINE_STATUS_OVERRUN_BIT)) rx_stats.hw_overrun++;
+        __uart_rx_store(*reg8(UART_BASE_ADDR, UART_RBR_REG_OFFSET));
+    }
+}
+
+static void __uart_rx_poll() {
+    uint32_t irq = irq_save();
+    __uart_rx_drain();
+    irq_restore(irq);
+}
+
+void uart_irq_handler(uint32_t cause) {
+    (void)cause;
+    // reading IIR acknowledges a pending THR empty interrupt
+    (void)*reg8(UART_BASE_ADDR, UART_INTR_IDENT_REG_OFFSET);
+    __uart_rx_drain();
+    if (__uart_write_ready()) {
+        __uart_tx_fill();
+    }
+}
+
 void uart_write(uint8_t byte) {
-    while (!__uart_write_ready())
-        ;
-    *reg8(UART_BASE_ADDR, UART_THR_REG_OFFSET) = byte;
+    while (tx_head - tx_tail >= UART_TX_BUF_SIZE) {
+        if (!irq_enabled()) __uart_tx_poll();
+    }
+    tx_buf[tx_head & UART_TX_BUF_MASK] = byte;
+    tx_head++;
+    __uart_tx_kick();
 }
 
-void uart_write_str(void *src, uint32_t len) {
-    for (uint32_t i = 0; i < len; ++i) uart_write(((uint8_t *)src)[i]);
+uint32_t uart_write_str(const void *src, uint32_t len) {
+    uint32_t free = UART_TX_BUF_SIZE - (tx_head - tx_tail);
+    uint32_t head = tx_head;
+    len = MIN(len, free);
+    for (uint32_t i = 0; i < len; ++i) {
+        tx_buf[(head + i) & UART_TX_BUF_MASK] = ((const uint8_t *)src)[i];
+    }
+    tx_head = head + len;
+    if (len) __uart_tx_kick();
+    return len;
 }
 
 void uart_write_flush() {
+    while (tx_tail != tx_head) {
+        if (!irq_enabled()) __uart_tx_poll();
+    }
     while (!__uart_write_idle())
         ;
 }
 
 uint8_t uart_read() {
-    while (!uart_read_ready())
-        ;
-    return *reg8(UART_BASE_ADDR, UART_RBR_REG_OFFSET);
+    while (rx_tail == rx_head) {
+        if (!irq_enabled()) __uart_rx_poll();
+    }
+    uint8_t byte = rx_buf[rx_tail & UART_RX_BUF_MASK];
+    rx_tail++;
+    return byte;
 }
 
 void uart_read_str(void *dst, uint32_t len) {
     for (uint32_t i = 0; i < len; ++i) ((uint8_t *)dst)[i] = uart_read();
 }
 
+void uart_rx_get_stats(uart_rx_stats_t *stats, int clear) {
+    uint32_t irq = irq_save();
+    stats->received   = rx_stats.received;
+    stats->dropped    = rx_stats.dropped;
+    stats->hw_overrun = rx_stats.hw_overrun;
+    if (clear) {
+        rx_stats.received   = 0;
+        rx_stats.dropped    = 0;
+        rx_stats.hw_overrun = 0;
+    }
+    irq_restore(irq);
+}
+
+void uart_rx_block_start(uint8_t *block0, uint8_t *block1, uint32_t len) {
+    uint32_t irq = irq_save();
+    rx_blk[0]      = block0;
+    rx_blk[1]      = block1;
+    rx_blk_len     = len;
+    rx_blk_pos     = 0;
+    rx_blk_fill    = 0;
+    rx_blk_next    = 0;
+    rx_blk_done[0] = 0;
+    rx_blk_done[1] = 0;
+    rx_blk_active  = 1;
+    irq_restore(irq);
+}
+
+void uart_rx_block_stop() {
+    rx_blk_active = 0;
+}
+
+uint8_t *uart_rx_block_poll() {
+    if (!irq_enabled()) __uart_rx_poll();
+    return rx_blk_done[rx_blk_next] ? rx_blk[rx_blk_next] : 0;
+}
+
+uint8_t *uart_rx_block_wait() {
+    uint8_t *block;
+    while (!(block = uart_rx_block_poll()))
+        ;
+    return block;
+}
+
+void uart_rx_block_release() {
+    uint32_t next = rx_blk_next;
+    rx_blk_next = next ^ 1;
+    rx_blk_done[next] = 0;
+}
+
 void putchar(char byte) {
     uart_write(byte);
 };
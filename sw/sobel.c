@@ -0,0 +1,61 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Compares a software Sobel filter against the user domain edge detection accelerator.
+
+#include "uart.h"
+#include "print.h"
+#include "util.h"
+#include "edge_detect.h"
+#include "image_data.h"
+
+uint8_t sw_edges[IMAGE_SIZE] __attribute__((aligned(4)));
+uint8_t hw_edges[IMAGE_SIZE] __attribute__((aligned(4)));
+
+static uint32_t absdiff(uint32_t a, uint32_t b) {
+    return (a > b) ? a - b : b - a;
+}
+
+/// @brief Sobel gradient magnitude |Gx| + |Gy|, saturated to 255, zero on the border
+void sobel_sw(const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t height) {
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            if (y == 0 || y == height - 1 || x == 0 || x == width - 1) {
+                dst[y * width + x] = 0;
+                continue;
+            }
+            const uint8_t *t = &src[(y - 1) * width + x];
+            const uint8_t *m = &src[y * width + x];
+            const uint8_t *b = &src[(y + 1) * width + x];
+            uint32_t gx = absdiff(t[1] + 2 * m[1] + b[1], t[-1] + 2 * m[-1] + b[-1]);
+            uint32_t gy = absdiff(b[-1] + 2 * b[0] + b[1], t[-1] + 2 * t[0] + t[1]);
+            uint32_t g  = gx + gy;
+            dst[y * width + x] = (g > 255) ? 255 : g;
+        }
+    }
+}
+
+int main() {
+    uart_init();
+
+    uint32_t t0 = get_mcycle();
+    sobel_sw(image_data, sw_edges, IMAGE_WIDTH, IMAGE_HEIGHT);
+    uint32_t t1 = get_mcycle();
+    edge_detect_frame(image_data, hw_edges, IMAGE_WIDTH, IMAGE_HEIGHT);
+    uint32_t t2 = get_mcycle();
+
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < IMAGE_SIZE; i++) {
+        if (sw_edges[i] != hw_edges[i]) {
+            mismatches++;
+        }
+    }
+
+    printf("Sobel %xx%x: software 0x%x cycles, hardware 0x%x cycles\n", IMAGE_WIDTH, IMAGE_HEIGHT,
+           t1 - t0, t2 - t1);
+    printf("Mismatches: 0x%x\n", mismatches);
+    uart_write_flush();
+
+    return (mismatches == 0) ? 1 : 0;
+}
@@ -0,0 +1,59 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Samples a few software kernels with the statistical profiler and dumps the histogram,
+// `make sample-profile PROFILE=sprof_demo` symbolizes it.
+
+#include "uart.h"
+#include "util.h"
+#include "sprof.h"
+
+#define DATA_WORDS 64
+
+uint32_t data[DATA_WORDS];
+volatile uint32_t sink;
+
+uint32_t crc32(const uint32_t *buf, uint32_t words) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint32_t i = 0; i < words; i++) {
+        crc ^= buf[i];
+        for (uint32_t bit = 0; bit < 32; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+void sort(uint32_t *buf, uint32_t words) {
+    for (uint32_t i = 1; i < words; i++) {
+        uint32_t val = buf[i];
+        uint32_t j   = i;
+        while (j > 0 && buf[j - 1] > val) {
+            buf[j] = buf[j - 1];
+            j--;
+        }
+        buf[j] = val;
+    }
+}
+
+void fill(uint32_t *buf, uint32_t words, uint32_t seed) {
+    for (uint32_t i = 0; i < words; i++) {
+        seed = seed * 1664525 + 1013904223; // LCG
+        buf[i] = seed;
+    }
+}
+
+int main() {
+    uart_init();
+
+    sprof_start(50, SPROF_MODE_PC);
+    for (uint32_t iter = 0; iter < 4; iter++) {
+        fill(data, DATA_WORDS, iter);
+        sort(data, DATA_WORDS);
+        sink = crc32(data, DATA_WORDS);
+    }
+    sprof_stop();
+    sprof_dump();
+    return 1;
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Checks that the edge detection accelerator clamps the configured frame width to
+// 4..EDGE_DETECT_MAX_WIDTH and that a row of the clamped width completes.
+
+#include "uart.h"
+#include "print.h"
+#include "util.h"
+#include "edge_detect.h"
+
+static uint32_t errors;
+
+static void check(const char *what, uint32_t width, uint32_t value, uint32_t expected) {
+    if (value != expected) {
+        // printf only formats %x
+        printf("FAIL ");
+        printf((char *)what);
+        printf(" (width %x): %x (expected %x)\n", width, value, expected);
+        errors++;
+    }
+}
+
+static void test_width(uint32_t width, uint32_t expected) {
+    edge_detect_init(width, 3);
+    uint32_t cfg = *reg32(USER_EDGE_DETECT_BASE_ADDR, EDGE_DETECT_SOBEL_CFG_REG_OFFSET);
+    check("width", width, (cfg >> EDGE_DETECT_SOBEL_CFG_WIDTH_BIT) & 0xFF, expected);
+    check("height", width, (cfg >> EDGE_DETECT_SOBEL_CFG_HEIGHT_BIT) & 0xFF, 3);
+
+    // a row is expected/4 words long, one word less must not complete it
+    volatile uint32_t *pixels = reg32(USER_EDGE_DETECT_BASE_ADDR, EDGE_DETECT_SOBEL_PIXELS_REG_OFFSET);
+    volatile uint32_t *status = reg32(USER_EDGE_DETECT_BASE_ADDR, EDGE_DETECT_SOBEL_STATUS_REG_OFFSET);
+    for (uint32_t i = 0; i < expected / 4 - 1; i++) *pixels = i;
+    check("rows before the last word", width, (*status >> EDGE_DETECT_SOBEL_STATUS_ROWS_BIT) & 0xFF, 0);
+    *pixels = 0;
+    check("rows after the last word", width, (*status >> EDGE_DETECT_SOBEL_STATUS_ROWS_BIT) & 0xFF, 1);
+}
+
+int main() {
+    uart_init();
+
+    test_width(0, 4);
+    test_width(2, 4);
+    test_width(4, 4);
+    test_width(EDGE_DETECT_MAX_WIDTH, EDGE_DETECT_MAX_WIDTH);
+    test_width(EDGE_DETECT_MAX_WIDTH + 4, EDGE_DETECT_MAX_WIDTH);
+    test_width(0xFF, EDGE_DETECT_MAX_WIDTH);
+
+    printf("Edge detect width bounds: ");
+    printf(errors ? "FAIL\n" : "ok\n");
+    uart_write_flush();
+
+    return errors ? 0 : 1;
+}
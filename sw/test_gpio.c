@@ -0,0 +1,134 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Checks the GPIO set/clear aliases and the waveform engine through the loopback of the
+// testbench and the C++ harness (outputs 3:0 are read back on inputs 7:4).
+
+#include "uart.h"
+#include "print.h"
+#include "gpio.h"
+#include "util.h"
+
+#define WAVE_DEPTH   8   // gpio WaveDepth
+#define WAVE_PERIOD  256 // cycles per pattern, well above the polling loop below
+#define WAVE_SLACK   64  // cycles the polling loop may be late
+
+static uint32_t errors;
+
+static void check(const char *what, uint32_t value, uint32_t expected) {
+    if (value != expected) {
+        // printf only formats %x
+        printf("FAIL ");
+        printf((char *)what);
+        printf(": %x (expected %x)\n", value, expected);
+        errors++;
+    }
+}
+
+static inline uint32_t cycles(void) {
+    uint32_t c;
+    asm volatile("csrr %0, mcycle" : "=r"(c)::"memory");
+    return c;
+}
+
+// outputs 3:0 as seen on inputs 7:4
+static uint32_t loopback(void) {
+    asm volatile("nop; nop; nop; nop; nop;"); // give the outputs time to propagate
+    return (gpio_read() >> 4) & 0xF;
+}
+
+static void test_aliases(void) {
+    gpio_set_direction(0xF, 0xF);
+    check("DIR after DIR_SET", *reg32(GPIO_BASE_ADDR, GPIO_DIR_REG_OFFSET), 0xF);
+    gpio_enable(0xFF);
+    check("EN after EN_SET", *reg32(GPIO_BASE_ADDR, GPIO_EN_REG_OFFSET), 0xFF);
+
+    gpio_pin_set(0);
+    gpio_pin_set(2);
+    gpio_pin_set(3);
+    check("OUT after OUT_SET", *reg32(GPIO_BASE_ADDR, GPIO_OUT_REG_OFFSET), 0xD);
+    gpio_pin_clear(2);
+    check("OUT after OUT_CLR", *reg32(GPIO_BASE_ADDR, GPIO_OUT_REG_OFFSET), 0x9);
+    check("OUT_SET read", *reg32(GPIO_BASE_ADDR, GPIO_OUT_SET_REG_OFFSET), 0x9);
+    check("OUT_CLR read", *reg32(GPIO_BASE_ADDR, GPIO_OUT_CLR_REG_OFFSET), 0x9);
+    check("loopback OUT", loopback(), 0x9);
+
+    // a cleared direction bit disables the output, the loopback reads 0 there
+    *reg32(GPIO_BASE_ADDR, GPIO_DIR_CLR_REG_OFFSET) = 0x8;
+    check("DIR after DIR_CLR", *reg32(GPIO_BASE_ADDR, GPIO_DIR_REG_OFFSET), 0x7);
+    check("loopback DIR", loopback(), 0x1);
+    gpio_pin_set_output(3);
+
+    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_SET_REG_OFFSET) = 0xF0;
+    *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_CLR_REG_OFFSET) = 0x30;
+    check("INTRPT_EN", *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_REG_OFFSET), 0xC0);
+    gpio_disable_interrupts(0xFF);
+    check("INTRPT_EN after CLR", *reg32(GPIO_BASE_ADDR, GPIO_INTRPT_EN_REG_OFFSET), 0);
+    gpio_get_interrupt_status(); // clear on read
+
+    gpio_disable(0xF0);
+    check("EN after EN_CLR", *reg32(GPIO_BASE_ADDR, GPIO_EN_REG_OFFSET), 0x0F);
+}
+
+static void test_wave(void) {
+    // the engine drives outputs 2:0 only, output 3 keeps its value
+    static const uint32_t patterns[WAVE_DEPTH] = {0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x0};
+    uint32_t seen[WAVE_DEPTH], when[WAVE_DEPTH];
+
+    gpio_write(0x8);
+    gpio_wave_disable();
+    *reg32(GPIO_BASE_ADDR, GPIO_WAVE_MASK_REG_OFFSET) = 0x7;
+    for (uint32_t i = 0; i < WAVE_DEPTH; i++) {
+        check("wave push", gpio_wave_push(patterns[i]), 1);
+    }
+    check("wave level", gpio_wave_level(), WAVE_DEPTH);
+    check("wave full", (*reg32(GPIO_BASE_ADDR, GPIO_WAVE_STATUS_REG_OFFSET) >>
+                        GPIO_WAVE_STATUS_FULL_BIT) & 1, 1);
+    check("wave push when full", gpio_wave_push(0x7), 0);
+    check("wave disabled", loopback(), 0x8);
+
+    // record every change of the loopback and when it happened
+    uint32_t n = 0, last = 0x8, start = cycles();
+    gpio_wave_config(WAVE_PERIOD, 0x7);
+    while (n < WAVE_DEPTH && cycles() - start < 2 * WAVE_DEPTH * WAVE_PERIOD) {
+        uint32_t in = (gpio_read() >> 4) & 0xF;
+        if (in != last) {
+            when[n]   = cycles();
+            seen[n++] = in;
+            last      = in;
+        }
+    }
+    gpio_wave_flush();
+    gpio_wave_disable();
+
+    check("wave patterns played", n, WAVE_DEPTH);
+    for (uint32_t i = 0; i < n; i++) {
+        check("wave pattern", seen[i], patterns[i] | 0x8);
+        if (i == 0) continue;
+        uint32_t gap = when[i] - when[i - 1];
+        if (gap + WAVE_SLACK < WAVE_PERIOD || gap > WAVE_PERIOD + WAVE_SLACK) {
+            check("wave period", gap, WAVE_PERIOD);
+        }
+    }
+    check("OUT after wave", *reg32(GPIO_BASE_ADDR, GPIO_OUT_REG_OFFSET), 0x8);
+    check("wave empty", (*reg32(GPIO_BASE_ADDR, GPIO_WAVE_STATUS_REG_OFFSET) >>
+                         GPIO_WAVE_STATUS_EMPTY_BIT) & 1, 1);
+}
+
+int main() {
+    uart_init();
+
+    test_aliases();
+    printf("GPIO aliases: ");
+    printf(errors ? "FAIL\n" : "ok\n");
+    uart_write_flush();
+
+    uint32_t alias_errors = errors;
+    test_wave();
+    printf("GPIO waveform: ");
+    printf(errors > alias_errors ? "FAIL\n" : "ok\n");
+    uart_write_flush();
+
+    return errors ? 0 : 1;
+}
@@ -9,18 +9,14 @@
 #include "print.h"
 #include "gpio.h"
 #include "util.h"
+#include "bitops.h"
 
 #define TB_FREQUENCY 20000000
 #define TB_BAUDRATE    125000
 
 unsigned int count_set_bits(unsigned int n)
 {
-    unsigned int count = 0;
-    while (n) {
-        count += n & 1;
-        n = n >> 1;
-    }
-    return count;
+    return popcount32(n);
 }
 
 int main() {
@@ -48,47 +44,35 @@ int main() {
     uint32_t t0, t1, t2, t3;
     uint32_t array[8] = {0x7bdf967f, 0xa6c04951, 0x3f78fb58, 0x4d6a542b, 0x9f7898b2, 0x2d9e72ad, 0x1f4fcbde};
     printf("Array: %x\n", array);
+    uart_write_flush();
+
+    // keep the timed regions free of printf, the UART would dominate the cycle count
     asm volatile("csrr %0, mcycle" : "=r"(t0)::"memory");
 
     uint32_t result_a = 0;
-    printf("result_a: %x\n", result_a);
-    result_a += count_set_bits(array[0]);
-    printf("result_a: %x\n", result_a);
-    result_a += count_set_bits(array[1]);
-    printf("result_a: %x\n", result_a);
-    result_a += count_set_bits(array[2]);
-    printf("result_a: %x\n", result_a);
-    result_a += count_set_bits(array[3]);
-    printf("result_a: %x\n", result_a);
-    result_a += count_set_bits(array[4]);
-    printf("result_a: %x\n", result_a);
-    result_a += count_set_bits(array[5]);
-    printf("result_a: %x\n", result_a);
-    result_a += count_set_bits(array[6]);
-    printf("result_a: %x\n", result_a);
-    result_a += count_set_bits(array[7]);
-    printf("result_a: %x\n", result_a);
+    for(int i = 0; i < 8; i++) {
+        result_a += count_set_bits(array[i]);
+    }
 
     asm volatile("csrr %0, mcycle" : "=r"(t1)::"memory");
 
-    for(volatile int i = 0; i < 128; i++) {
-        printf("i: %x\n", i);
-    }
-
     asm volatile("csrr %0, mcycle" : "=r"(t2)::"memory");
-    
+
     // Reset the accumulator
     *reg32(USER_SETBITCOUNT_BASE_ADDR, 0x0) = 0x0;
 
-    // Accumulate
-    for(int i = 0; i < 8; i++) {
-        printf("i: %x\n", i);
-        *reg32(USER_SETBITCOUNT_BASE_ADDR, 0x4) = array[i];
-    }
-    printf("Array: %x\n", array);
+    // Accumulate with back-to-back stores into the bulk window (consecutive words)
+    volatile uint32_t *bulk = reg32(USER_SETBITCOUNT_BASE_ADDR, 0x200);
+    bulk[0] = array[0];
+    bulk[1] = array[1];
+    bulk[2] = array[2];
+    bulk[3] = array[3];
+    bulk[4] = array[4];
+    bulk[5] = array[5];
+    bulk[6] = array[6];
+    bulk[7] = array[7];
     // Read result
     uint32_t result_b = *reg32(USER_SETBITCOUNT_BASE_ADDR, 0x8);
-    printf("result_b: %x\n", result_b);
 
     asm volatile("csrr %0, mcycle" : "=r"(t3)::"memory");
 
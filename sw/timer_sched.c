@@ -0,0 +1,53 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Runs a periodic sampling timer and a one-shot timer from the timer interrupt while the core
+// keeps computing, then checks that both fired as scheduled.
+
+#include "uart.h"
+#include "print.h"
+#include "timer.h"
+#include "gpio.h"
+#include "util.h"
+
+soft_timer_t sample_timer;
+soft_timer_t stop_timer;
+
+volatile uint32_t samples;
+volatile uint32_t sample_xor;
+volatile uint32_t running = 1;
+
+void sample(void *arg) {
+    (void)arg;
+    sample_xor ^= gpio_read();
+    samples++;
+}
+
+void stop(void *arg) {
+    soft_timer_stop(&sample_timer);
+    *(volatile uint32_t *)arg = 0;
+}
+
+int main() {
+    uart_init();
+    timer_init();
+
+    // sample every 200us, stop after 2ms
+    uint32_t t0 = timer_now();
+    soft_timer_start(&sample_timer, 200, 200, sample, 0);
+    soft_timer_start(&stop_timer, 2000, 0, stop, (void *)&running);
+
+    // compute in the meantime
+    uint32_t acc = 0;
+    while (running) {
+        acc = acc * 33 + 7;
+    }
+    uint32_t t1 = timer_now();
+
+    printf("Samples: 0x%x in 0x%x cycles (acc 0x%x)\n", samples, t1 - t0, acc);
+    uart_write_flush();
+
+    // expect 10 samples (the last one may race with the stop timer)
+    return (samples >= 9 && samples <= 10) ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Post-link report of the SRAM usage per bank: code, data and bss bytes of the allocated ELF
+# sections in every bank, the reserved stack and what is left. Warns if code spilled into the
+# data bank, where its fetches compete with the loads/stores (see link.ld).
+# Usage: bank_report.py --banks N --bank-size BYTES [--stack BYTES] <program.elf>
+
+import argparse
+import struct
+import sys
+
+SHT_NOBITS    = 8
+SHF_ALLOC     = 0x2
+
+
+def sections(path):
+    """(name, addr, size, kind) of the allocated sections of an ELF32 little-endian file."""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF" or elf[4] != 1 or elf[5] != 1:
+        sys.exit(f"{path}: not a 32 bit little-endian ELF file")
+    shoff, = struct.unpack_from("<I", elf, 0x20)
+    shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+    headers = [struct.unpack_from("<IIIIIIIIII", elf, shoff + i * shentsize) for i in range(shnum)]
+    strtab = headers[shstrndx][4]
+
+    result = []
+    for name, typ, flags, addr, _, size, *_ in headers:
+        if not flags & SHF_ALLOC or size == 0:
+            continue
+        name = elf[strtab + name:elf.index(b"\0", strtab + name)].decode()
+        # pinned code (.bank<n>.text) is part of .bank0/.data and counts as placed data
+        if name.startswith(".text"):
+            kind = "text"
+        elif typ == SHT_NOBITS:
+            kind = "bss"
+        else:
+            kind = "data"
+        result.append((name, addr, size, kind))
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--base", type=lambda v: int(v, 0), default=0x10000000)
+    parser.add_argument("--banks", type=int, default=2)
+    parser.add_argument("--bank-size", type=lambda v: int(v, 0), default=2048)
+    parser.add_argument("--stack", type=lambda v: int(v, 0), default=512,
+                        help="stack reserved at the end of the SRAM")
+    parser.add_argument("elf")
+    args = parser.parse_args()
+
+    usage = [dict(text=0, data=0, bss=0, stack=0) for _ in range(args.banks)]
+    sram_end = args.base + args.banks * args.bank_size
+    outside = []
+    # split every section (and the stack) at the bank boundaries
+    regions = sections(args.elf) + [("stack", sram_end - args.stack, args.stack, "stack")]
+    for name, addr, size, kind in regions:
+        if addr < args.base or addr + size > sram_end:
+            outside.append(name)
+            continue
+        while size > 0:
+            bank  = (addr - args.base) // args.bank_size
+            chunk = min(size, args.base + (bank + 1) * args.bank_size - addr)
+            usage[bank][kind] += chunk
+            addr += chunk
+            size -= chunk
+
+    print(f"{'bank':<6}{'start':>12}{'text':>8}{'data':>8}{'bss':>8}{'stack':>8}{'free':>8}")
+    for bank, u in enumerate(usage):
+        free = args.bank_size - sum(u.values())
+        print(f"{bank:<6}{args.base + bank * args.bank_size:>#12x}{u['text']:>8}{u['data']:>8}"
+              f"{u['bss']:>8}{u['stack']:>8}{free:>8}")
+    total = sum(sum(u.values()) for u in usage)
+    print(f"total {total} of {args.banks * args.bank_size} bytes used")
+
+    if args.banks > 1 and usage[0]["text"] and any(u["text"] for u in usage[1:]):
+        print(f"warning: code spilled beyond bank 0 ({sum(u['text'] for u in usage[1:])} bytes), "
+              "its fetches compete with the data accesses", file=sys.stderr)
+    if outside:
+        print(f"warning: sections outside of the SRAM: {', '.join(outside)}", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,229 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Deferred logging decoder
+//
+// Turns a UART capture of a program using DLOG (sw/lib/inc/dlog.h) back into text. The format
+// strings are read from the .dlog_fmt section of the firmware ELF. Bytes outside of records
+// (printf, uart_write) are copied unchanged, every record
+//   DLOG_SYNC, varint(format id), one field per conversion
+// is formatted like printf would: integer conversions (%d %i %u %x %X %o %c %p) take a LEB128
+// varint of the 32-bit value, %s a zero-terminated string. Flags, width and precision are
+// supported, '*' and length modifiers are not (the modifiers are skipped).
+//
+// With --stats the number of captured bytes and of the text they expand to are printed to
+// stderr at the end.
+//
+// Usage: dlog_decode [--stats] <program.elf> [<capture>]   (the capture defaults to stdin)
+
+#include <elf.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+static const uint8_t DlogSync = 0xFF; // DLOG_SYNC in sw/lib/inc/dlog.h
+
+//-------------------------------------------------------------------------------------------------
+// Format strings
+//-------------------------------------------------------------------------------------------------
+
+// contents of the .dlog_fmt section, indexed by the format id
+static bool load_formats(const char *path, std::vector<char> &formats) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        fprintf(stderr, "Failed to open %s\n", path);
+        return false;
+    }
+    std::vector<char> f((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (f.size() < sizeof(Elf32_Ehdr) || std::memcmp(f.data(), ELFMAG, SELFMAG) != 0 ||
+        f[EI_CLASS] != ELFCLASS32) {
+        fprintf(stderr, "%s is not a 32-bit ELF file\n", path);
+        return false;
+    }
+    const Elf32_Ehdr *eh = reinterpret_cast<const Elf32_Ehdr *>(f.data());
+    const Elf32_Shdr *sh = reinterpret_cast<const Elf32_Shdr *>(f.data() + eh->e_shoff);
+    const char *shstrtab = f.data() + sh[eh->e_shstrndx].sh_offset;
+
+    for (unsigned i = 0; i < eh->e_shnum; i++) {
+        if (std::strcmp(shstrtab + sh[i].sh_name, ".dlog_fmt") != 0) continue;
+        if (sh[i].sh_addr != 0) {
+            fprintf(stderr, "%s: .dlog_fmt is not linked at address 0 (see sw/link.ld)\n", path);
+            return false;
+        }
+        formats.assign(f.begin() + sh[i].sh_offset, f.begin() + sh[i].sh_offset + sh[i].sh_size);
+        formats.push_back('\0'); // terminate a truncated last string
+        return true;
+    }
+    fprintf(stderr, "%s has no .dlog_fmt section (no DLOG used?)\n", path);
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Records
+//-------------------------------------------------------------------------------------------------
+
+class Decoder {
+  public:
+    Decoder(const std::vector<char> &formats, const std::vector<uint8_t> &capture)
+        : formats_(formats), in_(capture) {}
+
+    // decodes the whole capture to out, returns the number of malformed records
+    unsigned run(std::string &out) {
+        unsigned errors = 0;
+        while (pos_ < in_.size()) {
+            uint8_t byte = in_[pos_++];
+            if (byte != DlogSync) {
+                out += char(byte);
+                continue;
+            }
+            size_t start = pos_;
+            std::string text;
+            if (record(text)) {
+                out += text;
+            } else {
+                // skip the sync byte only, the rest may be text again
+                errors++;
+                out += "<dlog: " + error_ + ">\n";
+                pos_ = start;
+            }
+        }
+        return errors;
+    }
+
+  private:
+    bool varint(uint32_t &value) {
+        value = 0;
+        for (unsigned shift = 0; shift < 35; shift += 7) {
+            if (pos_ >= in_.size()) return fail("truncated record");
+            uint8_t byte = in_[pos_++];
+            value |= uint32_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return fail("varint longer than 5 bytes");
+    }
+
+    bool string(std::string &value) {
+        value.clear();
+        while (pos_ < in_.size()) {
+            uint8_t byte = in_[pos_++];
+            if (!byte) return true;
+            value += char(byte);
+        }
+        return fail("truncated string");
+    }
+
+    bool record(std::string &text) {
+        uint32_t id;
+        if (!varint(id)) return false;
+        if (id >= formats_.size()) return fail("unknown format id " + std::to_string(id));
+
+        for (const char *fmt = &formats_[id]; *fmt; fmt++) {
+            if (*fmt != '%') {
+                text += *fmt;
+                continue;
+            }
+            // %[flags][width][.precision][length]conversion
+            std::string spec = "%";
+            fmt++;
+            while (*fmt && std::strchr("-+ #0", *fmt)) spec += *fmt++;
+            while (*fmt >= '0' && *fmt <= '9') spec += *fmt++;
+            if (*fmt == '.') {
+                spec += *fmt++;
+                while (*fmt >= '0' && *fmt <= '9') spec += *fmt++;
+            }
+            while (*fmt && std::strchr("hlLqjzt", *fmt)) fmt++;
+            if (!*fmt) break;
+
+            char conv = *fmt;
+            char buf[256];
+            uint32_t value;
+            std::string str;
+            switch (conv) {
+            case '%': text += '%'; continue;
+            case 'd':
+            case 'i':
+                if (!varint(value)) return false;
+                snprintf(buf, sizeof(buf), (spec + 'd').c_str(), int32_t(value));
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            case 'c':
+                if (!varint(value)) return false;
+                snprintf(buf, sizeof(buf), (spec + conv).c_str(), (unsigned)value);
+                break;
+            case 'p':
+                if (!varint(value)) return false;
+                snprintf(buf, sizeof(buf), (spec + "#010x").c_str(), (unsigned)value);
+                break;
+            case 's':
+                if (!string(str)) return false;
+                snprintf(buf, sizeof(buf), (spec + 's').c_str(), str.c_str());
+                break;
+            default:
+                return fail(std::string("unsupported conversion %") + conv + " in format id " +
+                            std::to_string(id));
+            }
+            text += buf;
+        }
+        return true;
+    }
+
+    bool fail(const std::string &error) {
+        error_ = error;
+        return false;
+    }
+
+    const std::vector<char> &formats_;
+    const std::vector<uint8_t> &in_;
+    size_t pos_ = 0;
+    std::string error_;
+};
+
+int main(int argc, char **argv) {
+    bool stats = false;
+    int arg    = 1;
+    if (arg < argc && !std::strcmp(argv[arg], "--stats")) {
+        stats = true;
+        arg++;
+    }
+    if (argc - arg < 1 || argc - arg > 2) {
+        fprintf(stderr, "Usage: %s [--stats] <program.elf> [<capture>]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<char> formats;
+    if (!load_formats(argv[arg], formats)) return 2;
+
+    std::vector<uint8_t> capture;
+    if (argc - arg == 2) {
+        std::ifstream in(argv[arg + 1], std::ios::binary);
+        if (!in) {
+            fprintf(stderr, "Failed to open %s\n", argv[arg + 1]);
+            return 2;
+        }
+        capture.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    } else {
+        std::cin >> std::noskipws;
+        capture.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+    }
+
+    std::string out;
+    unsigned errors = Decoder(formats, capture).run(out);
+    fwrite(out.data(), 1, out.size(), stdout);
+
+    if (stats) {
+        fprintf(stderr, "%zu bytes captured, %zu bytes of text (%.1fx)\n", capture.size(),
+                out.size(), capture.empty() ? 0.0 : double(out.size()) / double(capture.size()));
+    }
+    if (errors) fprintf(stderr, "%u malformed records\n", errors);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,480 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Instruction trace profiler
+//
+// Streams the execution trace written by cve2_tracer (core built with TRACE_EXECUTION, see
+// `make profile`) line by line and attributes the cycles between two retired instructions to
+// the functions of the firmware ELF. It reports
+//  - a flat profile with exclusive and inclusive cycles, instructions and calls per function,
+//  - call graph edges with call counts and inclusive cycles,
+//  - hot loops (taken backward branches) with iterations and cycles spent in the loop body,
+//  - loads and stores per function, split into SRAM, peripheral and user domain accesses,
+//  - optionally folded stacks for flamegraph.pl or speedscope (--folded <file>).
+//
+// Calls and returns are recognized from the instruction encoding (jal/jalr linking to ra or t0,
+// jalr through ra or t0 without linking, mret). Any other change of the control flow into the
+// vector table is treated as a trap entry.
+//
+// Usage: trace_prof [--top N] [--folded FILE] <program.elf> <trace.log>
+
+#include <elf.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Memory map, keep in sync with rtl/croc_pkg.sv and rtl/user_pkg.sv
+static const uint32_t SramBase   = 0x10000000;
+static const uint32_t SramEnd    = 0x10100000;
+static const uint32_t PeriphBase = 0x03000000;
+static const uint32_t PeriphEnd  = 0x04000000;
+static const uint32_t UserBase   = 0x20000000;
+static const uint32_t UserEnd    = 0x80000000;
+
+static const uint32_t VectorTableSize = 32 * 4;
+
+// RV32I opcodes and instructions needed to follow the control flow
+static const uint32_t OpcodeBranch = 0x63;
+static const uint32_t OpcodeJalr   = 0x67;
+static const uint32_t OpcodeJal    = 0x6f;
+static const uint32_t InsnMret     = 0x30200073;
+
+//-------------------------------------------------------------------------------------------------
+// Symbols
+//-------------------------------------------------------------------------------------------------
+
+struct Symbol {
+    uint32_t start;
+    uint32_t end;
+    std::string name;
+};
+
+class SymbolTable {
+  public:
+    bool load(const char *path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            fprintf(stderr, "Failed to open %s\n", path);
+            return false;
+        }
+        std::vector<char> f((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (f.size() < sizeof(Elf32_Ehdr) || std::memcmp(f.data(), ELFMAG, SELFMAG) != 0 ||
+            f[EI_CLASS] != ELFCLASS32) {
+            fprintf(stderr, "%s is not a 32-bit ELF file\n", path);
+            return false;
+        }
+        const Elf32_Ehdr *eh = reinterpret_cast<const Elf32_Ehdr *>(f.data());
+        const Elf32_Shdr *sh = reinterpret_cast<const Elf32_Shdr *>(f.data() + eh->e_shoff);
+
+        for (unsigned i = 0; i < eh->e_shnum; i++) {
+            if (sh[i].sh_type != SHT_SYMTAB) continue;
+            const Elf32_Sym *syms = reinterpret_cast<const Elf32_Sym *>(f.data() + sh[i].sh_offset);
+            const char *strtab    = f.data() + sh[sh[i].sh_link].sh_offset;
+            unsigned count        = sh[i].sh_size / sizeof(Elf32_Sym);
+            for (unsigned s = 0; s < count; s++) {
+                const Elf32_Sym &sym = syms[s];
+                unsigned type        = ELF32_ST_TYPE(sym.st_info);
+                if (sym.st_shndx == SHN_UNDEF || sym.st_shndx >= eh->e_shnum) continue;
+                if (!(sh[sym.st_shndx].sh_flags & SHF_EXECINSTR)) continue;
+                if (type != STT_FUNC && type != STT_NOTYPE) continue;
+                const char *name = strtab + sym.st_name;
+                // skip local assembler labels and RISC-V mapping symbols
+                if (!name[0] || name[0] == '$' || !std::strncmp(name, ".L", 2)) continue;
+                symbols_.push_back({sym.st_value, sym.st_value + sym.st_size, name});
+                if (!std::strcmp(name, "__vector_table")) vector_table_ = sym.st_value;
+            }
+        }
+        if (symbols_.empty()) {
+            fprintf(stderr, "%s has no function symbols\n", path);
+            return false;
+        }
+
+        // sort by address, sized symbols first so they win over labels at the same address
+        std::sort(symbols_.begin(), symbols_.end(), [](const Symbol &a, const Symbol &b) {
+            return a.start != b.start ? a.start < b.start : a.end > b.end;
+        });
+        std::vector<Symbol> unique;
+        for (const Symbol &sym : symbols_) {
+            if (unique.empty() || unique.back().start != sym.start) unique.push_back(sym);
+        }
+        symbols_.swap(unique);
+        // labels without a size extend up to the next symbol
+        for (size_t i = 0; i < symbols_.size(); i++) {
+            if (symbols_[i].end == symbols_[i].start) {
+                symbols_[i].end = (i + 1 < symbols_.size()) ? symbols_[i + 1].start : UINT32_MAX;
+            }
+        }
+        symbols_.push_back({0, 0, "??"}); // unknown code
+        return true;
+    }
+
+    // index of the function containing pc (the last entry for unknown code)
+    int lookup(uint32_t pc) {
+        auto cached = cache_.find(pc);
+        if (cached != cache_.end()) return cached->second;
+        int idx = int(symbols_.size()) - 1;
+        auto it = std::upper_bound(symbols_.begin(), symbols_.end() - 1, pc,
+                                   [](uint32_t v, const Symbol &s) { return v < s.start; });
+        if (it != symbols_.begin()) {
+            --it;
+            if (pc < it->end) idx = int(it - symbols_.begin());
+        }
+        cache_[pc] = idx;
+        return idx;
+    }
+
+    const std::string &name(int idx) const { return symbols_[idx].name; }
+    size_t size() const { return symbols_.size(); }
+    bool in_vector_table(uint32_t pc) const {
+        return vector_table_ != UINT32_MAX && pc >= vector_table_ &&
+               pc < vector_table_ + VectorTableSize;
+    }
+
+  private:
+    std::vector<Symbol> symbols_;
+    std::unordered_map<uint32_t, int> cache_;
+    uint32_t vector_table_ = UINT32_MAX;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Trace records
+//-------------------------------------------------------------------------------------------------
+
+enum Region { RegionSram, RegionPeriph, RegionUser, RegionOther, NumRegions };
+static const char *const RegionNames[NumRegions] = {"sram", "periph", "user", "other"};
+
+static Region classify(uint32_t addr) {
+    if (addr >= SramBase && addr < SramEnd) return RegionSram;
+    if (addr >= PeriphBase && addr < PeriphEnd) return RegionPeriph;
+    if (addr >= UserBase && addr < UserEnd) return RegionUser;
+    return RegionOther;
+}
+
+struct Record {
+    uint64_t cycle;
+    uint32_t pc;
+    uint32_t insn;
+    bool load;
+    bool store;
+    uint32_t addr;
+};
+
+// Time, Cycle, PC, Insn, decoded instruction, register and memory contents (tab separated)
+static bool parse_line(const std::string &line, Record &rec) {
+    size_t tab = line.find('\t'); // skip the time, its format depends on the simulator
+    if (tab == std::string::npos) return false;
+    char *end;
+    rec.cycle = std::strtoull(line.c_str() + tab + 1, &end, 10);
+    if (end == line.c_str() + tab + 1) return false; // header
+    if (*end != '\t') return false;
+    rec.pc = std::strtoul(end + 1, &end, 16);
+    if (*end != '\t') return false;
+    rec.insn = std::strtoul(end + 1, &end, 16);
+    if (*end != '\t') return false;
+
+    rec.load  = false;
+    rec.store = false;
+    size_t pa = line.find(" PA:0x");
+    if (pa != std::string::npos) {
+        rec.addr  = std::strtoul(line.c_str() + pa + 6, nullptr, 16);
+        rec.store = line.find(" store:", pa) != std::string::npos;
+        rec.load  = line.find(" load:", pa) != std::string::npos;
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Profiler
+//-------------------------------------------------------------------------------------------------
+
+struct FuncStats {
+    uint64_t exclusive = 0;
+    uint64_t inclusive = 0;
+    uint64_t insns     = 0;
+    uint64_t calls     = 0;
+    uint64_t loads[NumRegions]  = {};
+    uint64_t stores[NumRegions] = {};
+};
+
+struct EdgeStats {
+    uint64_t calls  = 0;
+    uint64_t cycles = 0;
+};
+
+struct Frame {
+    int func;
+    int caller; // function that called or was interrupted, -1 for the bottom frame
+    uint64_t entry;
+};
+
+class Profiler {
+  public:
+    explicit Profiler(SymbolTable &syms) : syms_(syms), funcs_(syms.size()) {}
+
+    void step(const Record &rec) {
+        if (have_prev_) {
+            account(prev_, rec.cycle - prev_.cycle);
+            transition(prev_, rec.pc, rec.cycle);
+        } else {
+            stack_.push_back({syms_.lookup(rec.pc), -1, rec.cycle});
+            funcs_[stack_.back().func].calls++;
+            rebuild_key();
+        }
+        prev_      = rec;
+        have_prev_ = true;
+    }
+
+    void finish() {
+        if (!have_prev_) return;
+        account(prev_, 1); // the cost of the last instruction is unknown
+        uint64_t now = prev_.cycle + 1;
+        while (stack_.size() > 1) pop(now);
+    }
+
+    void report(size_t top) const;
+    bool write_folded(const char *path) const;
+
+  private:
+    void account(const Record &rec, uint64_t cycles) {
+        int f = stack_.back().func;
+        funcs_[f].exclusive += cycles;
+        funcs_[f].insns++;
+        total_cycles_ += cycles;
+        total_insns_++;
+        // inclusive cycles count once per function, even if it is on the stack several times
+        for (size_t i = 0; i < stack_.size(); i++) {
+            bool seen = false;
+            for (size_t j = 0; j < i && !seen; j++) seen = stack_[j].func == stack_[i].func;
+            if (!seen) funcs_[stack_[i].func].inclusive += cycles;
+        }
+        pc_cycles_[rec.pc] += cycles;
+        if (rec.load) funcs_[f].loads[classify(rec.addr)]++;
+        if (rec.store) funcs_[f].stores[classify(rec.addr)]++;
+        folded_[key_] += cycles;
+    }
+
+    void transition(const Record &prev, uint32_t next_pc, uint64_t now) {
+        uint32_t opcode  = prev.insn & 0x7f;
+        uint32_t rd      = (prev.insn >> 7) & 0x1f;
+        uint32_t rs1     = (prev.insn >> 15) & 0x1f;
+        bool link        = (rd == 1 || rd == 5);
+        bool is_jump     = opcode == OpcodeJal || opcode == OpcodeJalr;
+        bool is_call     = is_jump && link;
+        bool is_ret      = opcode == OpcodeJalr && rd == 0 && (rs1 == 1 || rs1 == 5);
+        bool is_mret     = prev.insn == InsnMret;
+        bool control     = is_jump || opcode == OpcodeBranch || is_mret;
+        bool sequential  = next_pc == prev.pc + 4;
+        bool is_trap     = !sequential && (!control || syms_.in_vector_table(next_pc));
+        int next_func    = syms_.lookup(next_pc);
+
+        if (!sequential && next_pc < prev.pc && !is_call && !is_ret && !is_trap &&
+            (opcode == OpcodeBranch || opcode == OpcodeJal)) {
+            loops_[{prev.pc, next_pc}]++;
+        }
+
+        if (is_call || is_trap) {
+            push(next_func, now);
+        } else if (is_ret || is_mret) {
+            pop(now);
+        }
+        // jumps between functions (tail calls, returns to a different frame) move the top frame
+        if (stack_.back().func != next_func) {
+            stack_.back().func = next_func;
+            rebuild_key();
+        }
+    }
+
+    void push(int func, uint64_t now) {
+        if (stack_.size() >= MaxDepth) return;
+        int caller = stack_.back().func;
+        stack_.push_back({func, caller, now});
+        funcs_[func].calls++;
+        edges_[{caller, func}].calls++;
+        rebuild_key();
+    }
+
+    void pop(uint64_t now) {
+        if (stack_.size() <= 1) return;
+        const Frame &frame = stack_.back();
+        edges_[{frame.caller, frame.func}].cycles += now - frame.entry;
+        stack_.pop_back();
+        rebuild_key();
+    }
+
+    void rebuild_key() {
+        key_.clear();
+        for (const Frame &frame : stack_) {
+            if (!key_.empty()) key_ += ';';
+            key_ += syms_.name(frame.func);
+        }
+    }
+
+    static const size_t MaxDepth = 256;
+
+    SymbolTable &syms_;
+    std::vector<FuncStats> funcs_;
+    std::map<std::pair<int, int>, EdgeStats> edges_;
+    std::map<std::pair<uint32_t, uint32_t>, uint64_t> loops_; // (branch pc, target) -> taken
+    std::unordered_map<uint32_t, uint64_t> pc_cycles_;
+    std::unordered_map<std::string, uint64_t> folded_;
+    std::vector<Frame> stack_;
+    std::string key_;
+    Record prev_{};
+    bool have_prev_        = false;
+    uint64_t total_cycles_ = 0;
+    uint64_t total_insns_  = 0;
+};
+
+static double percent(uint64_t part, uint64_t total) {
+    return total ? 100.0 * double(part) / double(total) : 0.0;
+}
+
+void Profiler::report(size_t top) const {
+    printf("Total: %llu cycles, %llu instructions, CPI %.3f\n\n", (unsigned long long)total_cycles_,
+           (unsigned long long)total_insns_,
+           total_insns_ ? double(total_cycles_) / double(total_insns_) : 0.0);
+
+    std::vector<int> order;
+    for (size_t i = 0; i < funcs_.size(); i++) {
+        if (funcs_[i].insns || funcs_[i].inclusive) order.push_back(int(i));
+    }
+    std::sort(order.begin(), order.end(),
+              [&](int a, int b) { return funcs_[a].exclusive > funcs_[b].exclusive; });
+    size_t n = (top && top < order.size()) ? top : order.size();
+
+    printf("Flat profile\n");
+    printf("%-28s %12s %7s %12s %7s %10s %8s %6s\n", "function", "excl", "%", "incl", "%", "insns",
+           "calls", "CPI");
+    for (size_t i = 0; i < n; i++) {
+        const FuncStats &f = funcs_[order[i]];
+        printf("%-28s %12llu %6.2f%% %12llu %6.2f%% %10llu %8llu %6.2f\n",
+               syms_.name(order[i]).c_str(), (unsigned long long)f.exclusive,
+               percent(f.exclusive, total_cycles_), (unsigned long long)f.inclusive,
+               percent(f.inclusive, total_cycles_), (unsigned long long)f.insns,
+               (unsigned long long)f.calls, f.insns ? double(f.exclusive) / double(f.insns) : 0.0);
+    }
+
+    printf("\nCall graph (caller -> callee)\n");
+    std::vector<std::pair<std::pair<int, int>, EdgeStats>> edges(edges_.begin(), edges_.end());
+    std::sort(edges.begin(), edges.end(),
+              [](const auto &a, const auto &b) { return a.second.cycles > b.second.cycles; });
+    printf("%-50s %8s %12s\n", "edge", "calls", "incl");
+    for (size_t i = 0; i < edges.size() && (!top || i < top); i++) {
+        std::string edge = syms_.name(edges[i].first.first) + " -> " +
+                           syms_.name(edges[i].first.second);
+        printf("%-50s %8llu %12llu\n", edge.c_str(), (unsigned long long)edges[i].second.calls,
+               (unsigned long long)edges[i].second.cycles);
+    }
+
+    printf("\nHot loops (taken backward branches)\n");
+    struct Loop {
+        uint32_t from, to;
+        uint64_t iterations, cycles;
+    };
+    std::vector<Loop> loops;
+    for (const auto &entry : loops_) {
+        uint64_t cycles = 0;
+        for (const auto &pc : pc_cycles_) {
+            if (pc.first >= entry.first.second && pc.first <= entry.first.first) cycles += pc.second;
+        }
+        loops.push_back({entry.first.first, entry.first.second, entry.second, cycles});
+    }
+    std::sort(loops.begin(), loops.end(),
+              [](const Loop &a, const Loop &b) { return a.cycles > b.cycles; });
+    printf("%-28s %-21s %10s %12s %7s\n", "function", "body", "iterations", "cycles", "%");
+    for (size_t i = 0; i < loops.size() && (!top || i < top); i++) {
+        char body[32];
+        snprintf(body, sizeof(body), "%08x-%08x", loops[i].to, loops[i].from);
+        printf("%-28s %-21s %10llu %12llu %6.2f%%\n",
+               syms_.name(syms_.lookup(loops[i].from)).c_str(), body,
+               (unsigned long long)loops[i].iterations, (unsigned long long)loops[i].cycles,
+               percent(loops[i].cycles, total_cycles_));
+    }
+
+    printf("\nMemory accesses (loads/stores)\n");
+    printf("%-28s", "function");
+    for (int r = 0; r < NumRegions; r++) printf(" %17s", RegionNames[r]);
+    printf("\n");
+    for (size_t i = 0; i < n; i++) {
+        const FuncStats &f = funcs_[order[i]];
+        uint64_t any = 0;
+        for (int r = 0; r < NumRegions; r++) any += f.loads[r] + f.stores[r];
+        if (!any) continue;
+        printf("%-28s", syms_.name(order[i]).c_str());
+        for (int r = 0; r < NumRegions; r++) {
+            char cell[32];
+            snprintf(cell, sizeof(cell), "%llu/%llu", (unsigned long long)f.loads[r],
+                     (unsigned long long)f.stores[r]);
+            printf(" %17s", cell);
+        }
+        printf("\n");
+    }
+}
+
+bool Profiler::write_folded(const char *path) const {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "Failed to open %s\n", path);
+        return false;
+    }
+    for (const auto &entry : folded_) {
+        if (entry.second) fprintf(out, "%s %llu\n", entry.first.c_str(),
+                                  (unsigned long long)entry.second);
+    }
+    fclose(out);
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Main
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+    size_t top         = 20;
+    const char *folded = nullptr;
+    std::vector<const char *> files;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--top") && i + 1 < argc) {
+            top = std::strtoul(argv[++i], nullptr, 0);
+        } else if (!std::strcmp(argv[i], "--folded") && i + 1 < argc) {
+            folded = argv[++i];
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.size() != 2) {
+        fprintf(stderr, "Usage: %s [--top N] [--folded FILE] <program.elf> <trace.log>\n", argv[0]);
+        return 1;
+    }
+
+    SymbolTable syms;
+    if (!syms.load(files[0])) return 1;
+
+    std::ifstream trace(files[1]);
+    if (!trace) {
+        fprintf(stderr, "Failed to open %s\n", files[1]);
+        return 1;
+    }
+
+    Profiler prof(syms);
+    std::string line;
+    Record rec;
+    while (std::getline(trace, line)) {
+        if (parse_line(line, rec)) prof.step(rec); // skips the header
+    }
+    prof.finish();
+
+    prof.report(top);
+    if (folded && !prof.write_folded(folded)) return 1;
+    return 0;
+}
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Host side of the UART boot loader (sw/bootrom/bootrom.S): switches the baud rate, downloads
+# a program (the verilog hex of sw/bin) segment by segment and starts it. Failed segments are
+# sent again. Needs pyserial.
+# Usage: uart_boot.py [--divisor N] [--entry ADDR] <serial port> <program.hex>
+
+import argparse
+import sys
+import time
+
+CHUNK = 1024  # bytes per load command, a failed load only repeats its chunk
+
+
+def read_hex(path):
+    """[(addr, bytes)] of the contiguous segments of a verilog hex file (objcopy -O verilog)."""
+    segments = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+            if line.startswith("@"):
+                segments.append((int(line[1:], 16), bytearray()))
+            elif segments:
+                segments[-1][1].extend(int(b, 16) for b in line.split())
+            else:
+                sys.exit(f"{path}: data before the first address")
+    return [(addr, bytes(data + b"\0" * (-len(data) % 4))) for addr, data in segments]
+
+
+def checksum(words):
+    """sum = rotl(sum, 1) + word over all words, as the boot loader computes it."""
+    s = 0
+    for w in words:
+        s = (((s << 1) | (s >> 31)) + w) & 0xFFFFFFFF
+    return s
+
+
+def u32(value):
+    return value.to_bytes(4, "little")
+
+
+class Loader:
+    def __init__(self, port):
+        self.port = port
+
+    def command(self, cmd, expected):
+        self.port.reset_input_buffer()
+        self.port.write(cmd)
+        self.port.flush()
+        answer = self.port.read(1)
+        if answer != expected:
+            raise IOError(f"expected {expected!r}, got {answer!r}")
+
+    def set_divisor(self, divisor, clk):
+        self.command(b"b" + u32(divisor), b"K")
+        # the loader switches once its answer is sent
+        time.sleep(0.01)
+        self.port.baudrate = round(clk / (16 * divisor))
+
+    def load(self, addr, data):
+        words = [int.from_bytes(data[i:i + 4], "little") for i in range(0, len(data), 4)]
+        frame = b"l" + u32(addr) + u32(len(data)) + data + u32(checksum([addr, len(data)] + words))
+        self.command(frame, b"O")
+
+    def jump(self, entry):
+        self.command(b"j" + u32(entry), b"J")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--baud", type=int, default=125000,
+                        help="baud rate of the boot loader after reset (config.h UART_BAUD)")
+    parser.add_argument("--clk", type=float, default=20e6, help="SoC clock frequency in Hz")
+    parser.add_argument("--divisor", type=int, default=1,
+                        help="UART divisor for the download, baud = clk / (16 * divisor)")
+    parser.add_argument("--entry", type=lambda v: int(v, 0), default=0x10000080)
+    parser.add_argument("--retries", type=int, default=3)
+    parser.add_argument("--timeout", type=float, default=1.0, help="answer timeout in seconds")
+    parser.add_argument("port")
+    parser.add_argument("hex")
+    args = parser.parse_args()
+
+    try:
+        import serial
+    except ImportError:
+        sys.exit("uart_boot.py needs pyserial (pip install pyserial)")
+
+    segments = read_hex(args.hex)
+    with serial.Serial(args.port, args.baud, timeout=args.timeout) as port:
+        loader = Loader(port)
+        # the greeting is only sent once after reset, a '?' also shows the loader is alive
+        loader.command(b"\n", b"?")
+        if args.divisor:
+            loader.set_divisor(args.divisor, args.clk)
+            print(f"switched to {port.baudrate} baud")
+
+        start = time.time()
+        total = 0
+        for addr, data in segments:
+            for offset in range(0, len(data), CHUNK):
+                chunk = data[offset:offset + CHUNK]
+                for attempt in range(args.retries + 1):
+                    try:
+                        loader.load(addr + offset, chunk)
+                        break
+                    except IOError as e:
+                        if attempt == args.retries:
+                            sys.exit(f"loading 0x{addr + offset:08x} failed: {e}")
+                        print(f"retrying 0x{addr + offset:08x} ({e})", file=sys.stderr)
+                total += len(chunk)
+        elapsed = time.time() - start
+        print(f"loaded {total} bytes in {elapsed:.2f}s ({total / max(elapsed, 1e-6) / 1024:.1f} KiB/s)")
+
+        loader.jump(args.entry)
+        print(f"started at 0x{args.entry:08x}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
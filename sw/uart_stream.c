@@ -0,0 +1,66 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Streams frames through the UART in loopback mode: frame N is processed while frame N+1 is
+// received into the other half of the double buffer. Reports the sustained receive rate.
+
+#include "uart.h"
+#include "print.h"
+#include "util.h"
+#include "image_data.h"
+
+#define NUM_FRAMES 4
+
+uint8_t rx_block0[IMAGE_SIZE] __attribute__((aligned(4)));
+uint8_t rx_block1[IMAGE_SIZE] __attribute__((aligned(4)));
+
+uint32_t checksum(const uint8_t *data, uint32_t len) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < len; i++) {
+        sum = (sum << 1 | sum >> 31) ^ data[i];
+    }
+    return sum;
+}
+
+int main() {
+    uart_init();
+    uart_rx_stats_t stats;
+    uint32_t errors = 0;
+    uint32_t expected = checksum(image_data, IMAGE_SIZE);
+
+    uart_loopback_enable();
+    uart_rx_get_stats(&stats, 1);
+    uart_rx_block_start(rx_block0, rx_block1, IMAGE_SIZE);
+
+    uint32_t sent = 0;
+    uint32_t frames = 0;
+    uint32_t t0 = get_mcycle();
+    while (frames < NUM_FRAMES) {
+        // keep the transmit ring buffer topped up
+        if (sent < NUM_FRAMES * IMAGE_SIZE) {
+            uint32_t offs = sent % IMAGE_SIZE;
+            sent += uart_write_str(&image_data[offs], IMAGE_SIZE - offs);
+        }
+        uint8_t *block = uart_rx_block_poll();
+        if (block) {
+            errors += (checksum(block, IMAGE_SIZE) != expected);
+            uart_rx_block_release();
+            frames++;
+        }
+    }
+    uint32_t t1 = get_mcycle();
+
+    uart_rx_block_stop();
+    uart_loopback_disable();
+    uart_rx_get_stats(&stats, 0);
+
+    uint32_t bytes = NUM_FRAMES * IMAGE_SIZE;
+    printf("Streamed 0x%x bytes in 0x%x cycles (0x%x cycles/byte)\n", bytes, t1 - t0,
+           (t1 - t0) / bytes);
+    printf("Received 0x%x, dropped 0x%x, overruns 0x%x, errors 0x%x\n", stats.received,
+           stats.dropped, stats.hw_overrun, errors);
+    uart_write_flush();
+
+    return (errors == 0 && stats.dropped == 0) ? 1 : 0;
+}
@@ -0,0 +1,278 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Design-space sweep: builds the cartesian product of parameter overrides and evaluates every
+# point in its own directory (<out-dir>/<point>/), several points in parallel:
+#   sw        the benchmark programs (sw/bench_*.c) built for the point (SRAM size, -march)
+#   sim       a Verilator harness with the overrides, runs the benchmarks (kernel cycles)
+#   yosys     synthesis of croc_chip (cell area)
+#   openroad  place & route (area, WNS, fmax and power), needs the yosys stage
+# and writes one CSV row per point with all results to <out-dir>/results.csv.
+#
+# Parameters are the Verilog defines the RTL understands:
+#   NUM_SRAM_BANKS, SRAM_BANK_WORDS, SRAM_INTERLEAVE   rtl/croc_pkg.sv
+#   LOOP_CACHE_WORDS                                    rtl/croc_pkg.sv
+#   CORE_RV32M (RV32MNone, RV32MSlow, RV32MFast, RV32MSingleCycle), CORE_RV32B   rtl/core_wrap.sv
+#   USER_MAC_COEF_WORDS (0 removes the MAC unit)         rtl/user_pkg.sv
+# Defines without a value in the RTL defaults are left out for that point ("-" as value).
+#
+# Usage: sweep.py [-j N] [--stages sw,sim,yosys,openroad] NAME=v1,v2 [NAME=v1,v2 ...]
+
+import argparse
+import concurrent.futures
+import csv
+import glob
+import itertools
+import os
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import time
+
+PROJ_DIR = os.path.realpath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, os.path.join(PROJ_DIR, "verilator", "scripts"))
+from bench_csv import parse_log  # noqa: E402
+
+STAGES = ["sw", "sim", "yosys", "openroad"]
+
+YOSYS_AREA_RE = re.compile(r"Chip area for (?:top )?module '\\?croc_chip[^']*': ([\d.]+)")
+OR_AREA_RE    = re.compile(r"Total Active Area:\s+([\d.]+) um2")
+OR_WNS_RE     = re.compile(r"^wns(?: max)?\s+(-?[\d.eE+-]+)", re.M)
+OR_POWER_RE   = re.compile(r"^Total\s+\S+\s+\S+\s+\S+\s+([\d.eE+-]+)", re.M)
+OR_SLACK_RE   = re.compile(r"critical path slack\n-+\n(-?[\d.eE+-]+)")
+SDC_PERIOD_RE = re.compile(r"set TCK_SYS\s+([\d.]+)")
+
+# software variables that follow a parameter (sw/Makefile)
+SW_VARS = {"NUM_SRAM_BANKS": "SRAM_NUM_BANKS", "SRAM_BANK_WORDS": "SRAM_BANK_WORDS",
+           "USER_MAC_COEF_WORDS": "MAC_COEF_WORDS"}
+# parameters the harness needs as C defines as well (verilator/harness.cpp)
+HARNESS_DEFINES = ["NUM_SRAM_BANKS", "SRAM_BANK_WORDS", "SRAM_INTERLEAVE"]
+
+
+def point_name(point):
+    return "_".join(f"{k.lower()}-{v}" for k, v in point.items()) or "default"
+
+
+def riscv_march(point):
+    """-march of the software for the core extensions of a point."""
+    march = "rv32i"
+    if point.get("CORE_RV32M", "RV32MNone") not in ("-", "RV32MNone"):
+        march += "m"
+    march += "_zicsr"
+    if point.get("CORE_RV32B", "RV32BNone") not in ("-", "RV32BNone"):
+        march += "_zba_zbb_zbs"
+    return march
+
+
+class Point:
+    def __init__(self, params, args):
+        self.params  = params
+        self.defines = {k: v for k, v in params.items() if v != "-"}
+        self.args    = args
+        self.name    = point_name(params)
+        self.dir     = os.path.join(args.out_dir, self.name)
+        self.result  = dict(params, point=self.name, status="ok", message="")
+
+    def run(self, cmd, log, cwd=PROJ_DIR, env=None):
+        """runs a stage command with its output in log, raises on failure"""
+        with open(log, "w") as f:
+            proc = subprocess.run(cmd, cwd=cwd, stdout=f, stderr=subprocess.STDOUT,
+                                  env=dict(os.environ, **(env or {})))
+        if proc.returncode != 0:
+            raise RuntimeError(f"{os.path.basename(log)} failed ({os.path.relpath(log, PROJ_DIR)})")
+
+    def evaluate(self):
+        os.makedirs(self.dir, exist_ok=True)
+        t_start = time.monotonic()
+        try:
+            for stage in STAGES:
+                if stage in self.args.stages:
+                    getattr(self, "stage_" + stage)()
+        except RuntimeError as e:
+            self.result["status"]  = "fail"
+            self.result["message"] = str(e)
+        self.result["wall_s"] = round(time.monotonic() - t_start, 1)
+        return self.result
+
+    # ---------------------------------------------------------------------------------------------
+    # Stages
+    # ---------------------------------------------------------------------------------------------
+
+    def stage_sw(self):
+        # a private copy of sw/, the library objects depend on the SRAM configuration
+        sw_dir = os.path.join(self.dir, "sw")
+        shutil.rmtree(sw_dir, ignore_errors=True)
+        shutil.copytree(os.path.join(PROJ_DIR, "sw"), sw_dir,
+                        ignore=shutil.ignore_patterns("bin", "*.o", "golden"))
+        make_vars = [f"{SW_VARS[k]}={v}" for k, v in self.defines.items() if k in SW_VARS]
+        make_vars.append(f"RISCV_MARCH={riscv_march(self.params)}")
+        make_vars.append(f"CROC_PKG={os.path.join(PROJ_DIR, 'rtl', 'croc_pkg.sv')}")
+        targets = [f"bin/{b}.hex" for b in self.args.benches]
+        self.run(["make", "-C", sw_dir] + make_vars + targets, os.path.join(self.dir, "sw.log"))
+
+    def stage_sim(self):
+        mdir    = os.path.join(self.dir, "obj_harness")
+        cflags  = self.args.cflags + "".join(f" -D{k}={v}" for k, v in self.defines.items()
+                                             if k in HARNESS_DEFINES)
+        cmd = [self.args.verilator] + shlex.split(self.args.verilator_args)
+        cmd += [f"+define+{k}={v}" for k, v in self.defines.items()]
+        cmd += ["-O3", "-CFLAGS", cflags, "--threads", str(self.args.threads), "--Mdir", mdir,
+                "-f", "croc_harness.f", "harness.vlt", "harness.cpp"]
+        self.run(cmd, os.path.join(self.dir, "verilator.log"),
+                 cwd=os.path.join(PROJ_DIR, "verilator"))
+
+        bench_dir = os.path.join(self.dir, "bench")
+        os.makedirs(bench_dir, exist_ok=True)
+        for bench in self.args.benches:
+            hex_path = os.path.join(self.dir, "sw", "bin", bench + ".hex")
+            log = os.path.join(bench_dir, bench + ".log")
+            try:
+                self.run([os.path.join(mdir, "Vcroc_soc"), hex_path], log, cwd=bench_dir)
+            except RuntimeError:
+                pass  # a failing program (e.g. bench_mac without the MAC unit) only lacks results
+            rows, exit_code = parse_log(log)
+            if exit_code != 1:
+                self.result[f"{bench}/exit_code"] = exit_code
+            for kernel, _, _, cycles_median, *_ in rows:
+                self.result[f"{bench}/{kernel}"] = cycles_median
+
+    def stage_yosys(self):
+        ys_dir = os.path.join(self.dir, "yosys")
+        for sub in ("out", "tmp", "reports"):
+            os.makedirs(os.path.join(ys_dir, sub), exist_ok=True)
+        # croc.flist with absolute paths (it is relative to the repository) and the overrides
+        flist = os.path.join(ys_dir, "croc.flist")
+        with open(os.path.join(PROJ_DIR, "croc.flist")) as src, open(flist, "w") as dst:
+            for line in src:
+                line = line.strip()
+                if line.startswith("+incdir+"):
+                    line = "+incdir+" + os.path.join(PROJ_DIR, line[len("+incdir+"):])
+                elif line and not line.startswith("+"):
+                    line = os.path.join(PROJ_DIR, line)
+                dst.write(line + "\n")
+            for k, v in self.defines.items():
+                dst.write(f"+define+{k}={v}\n")
+        env = dict(SV_FLIST=flist, TOP_DESIGN="croc_chip", TMP=os.path.join(ys_dir, "tmp"),
+                   OUT=os.path.join(ys_dir, "out"), REPORTS=os.path.join(ys_dir, "reports"))
+        self.run([self.args.yosys, "-c", os.path.join(PROJ_DIR, "yosys", "scripts",
+                                                       "yosys_synthesis.tcl")],
+                 os.path.join(ys_dir, "yosys.log"), cwd=os.path.join(PROJ_DIR, "yosys"), env=env)
+
+        with open(os.path.join(ys_dir, "reports", "croc_chip_area.rpt")) as f:
+            m = YOSYS_AREA_RE.search(f.read())
+        if m:
+            self.result["yosys_area_um2"] = float(m.group(1))
+
+    def stage_openroad(self):
+        or_dir = os.path.join(self.dir, "openroad")
+        dirs = {d: os.path.join(or_dir, d) for d in ("save", "reports", "out")}
+        for d in dirs.values():
+            os.makedirs(d, exist_ok=True)
+        env = dict(NETLIST=os.path.join(self.dir, "yosys", "out", "croc_chip_yosys.v"),
+                   TOP_DESIGN="croc_chip", PROJ_NAME="croc", SAVE=dirs["save"],
+                   REPORTS=dirs["reports"], OR_OUT=dirs["out"],
+                   PDK=os.path.join(PROJ_DIR, "ihp13", "pdk"), QT_QPA_PLATFORM="offscreen")
+        log = os.path.join(or_dir, "croc.log")
+        self.run([self.args.openroad, "scripts/chip.tcl", "-log", log],
+                 os.path.join(or_dir, "openroad.log"), cwd=os.path.join(PROJ_DIR, "openroad"),
+                 env=env)
+
+        finals = sorted(glob.glob(os.path.join(dirs["reports"], "*_croc.final.rpt")))
+        if not finals:
+            raise RuntimeError("no final OpenROAD report")
+        with open(finals[-1], errors="replace") as f:
+            report = f.read()
+        # the die is fixed (chip.tcl), the standard cells and macros placed on it are what varies
+        m = OR_AREA_RE.search(report)
+        if m:
+            self.result["or_area_um2"] = float(m.group(1))
+        m = OR_WNS_RE.search(report)
+        if m:
+            self.result["wns_ns"] = float(m.group(1))
+        m = OR_SLACK_RE.search(report)
+        if m:
+            slack = float(m.group(1))
+            # the clock period minus the worst slack is the shortest period that still works
+            self.result["fmax_mhz"] = round(1e3 / (self.args.period - slack), 1)
+        m = OR_POWER_RE.search(report)
+        if m:
+            self.result["power_mw"] = round(float(m.group(1)) * 1e3, 3)
+
+
+def parse_param(text):
+    name, _, values = text.partition("=")
+    if not name or not values:
+        raise argparse.ArgumentTypeError(f"expected NAME=v1,v2,..., got '{text}'")
+    return name, [v for v in values.split(",") if v]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-j", "--jobs", type=int, default=1, help="points evaluated in parallel")
+    parser.add_argument("--stages", default=",".join(STAGES),
+                        help="comma separated subset of " + ", ".join(STAGES))
+    parser.add_argument("--benches", help="comma separated programs (default: sw/bench_*.c)")
+    parser.add_argument("--out-dir", default=os.path.join(PROJ_DIR, "sweep", "out"))
+    parser.add_argument("--csv", help="result table (default: <out-dir>/results.csv)")
+    parser.add_argument("--verilator", default="verilator")
+    parser.add_argument("--verilator-args", default="", help="harness build arguments (Makefile)")
+    parser.add_argument("--cflags", default="-O3", help="C++ flags of the harness build")
+    parser.add_argument("--threads", type=int, default=1, help="Verilator threads per harness")
+    parser.add_argument("--yosys", default="yosys")
+    parser.add_argument("--openroad", default="openroad")
+    parser.add_argument("params", nargs="*", type=parse_param, help="NAME=v1,v2,...")
+    args = parser.parse_args()
+
+    args.stages = [s for s in args.stages.replace(" ", ",").split(",") if s]
+    unknown = set(args.stages) - set(STAGES)
+    if unknown:
+        parser.error(f"unknown stages: {', '.join(sorted(unknown))}")
+    if "sim" in args.stages and "sw" not in args.stages:
+        parser.error("the sim stage needs the sw stage")
+    if "openroad" in args.stages and "yosys" not in args.stages:
+        parser.error("the openroad stage needs the yosys stage")
+    args.benches = (args.benches.split(",") if args.benches else
+                    sorted(os.path.basename(p)[:-2]
+                           for p in glob.glob(os.path.join(PROJ_DIR, "sw", "bench_*.c"))))
+    args.out_dir = os.path.realpath(args.out_dir)
+    with open(os.path.join(PROJ_DIR, "openroad", "src", "constraints.sdc")) as f:
+        args.period = float(SDC_PERIOD_RE.search(f.read()).group(1))
+
+    names  = [name for name, _ in args.params]
+    points = [dict(zip(names, values))
+              for values in itertools.product(*(values for _, values in args.params))]
+    print(f"{len(points)} points, stages {', '.join(args.stages)}, {args.jobs} in parallel",
+          flush=True)
+
+    results = []
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(args.jobs, 1)) as pool:
+        futures = [pool.submit(Point(p, args).evaluate) for p in points]
+        for future in concurrent.futures.as_completed(futures):
+            r = future.result()
+            results.append(r)
+            detail = f" ({r['message']})" if r["message"] else ""
+            print(f"[{r['status'].upper():>4}] {r['point']:<48} {r['wall_s']:9.1f} s{detail}",
+                  flush=True)
+
+    # one row per point: parameters, PPA, then the kernel cycles (median)
+    order = {point_name(p): i for i, p in enumerate(points)}
+    results.sort(key=lambda r: order[r["point"]])
+    ppa     = ["yosys_area_um2", "or_area_um2", "wns_ns", "fmax_mhz", "power_mw"]
+    kernels = sorted({k for r in results for k in r if "/" in k})
+    fields  = ["point"] + names + ["status"] + ppa + kernels + ["wall_s", "message"]
+    csv_path = args.csv or os.path.join(args.out_dir, "results.csv")
+    os.makedirs(os.path.dirname(csv_path), exist_ok=True)
+    with open(csv_path, "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=fields, extrasaction="ignore")
+        writer.writeheader()
+        writer.writerows(results)
+    print(f"results: {os.path.relpath(csv_path, PROJ_DIR)}")
+    return 0 if all(r["status"] == "ok" for r in results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,467 @@
+// Copyright (c) 2024 ETH Zurich and University of Bologna.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Fast C++ simulation harness for croc_soc
+//
+// tb_croc_soc loads every program word by word over JTAG and polls CORESTATUS over JTAG, so most
+// simulated time is spent bit-banging the debug module. This harness instead
+//  - preloads the program (ELF or `objcopy -O verilog` hex) straight into the SRAM bank arrays,
+//  - releases the core with fetch_en_i (the same enable soc_ctrl FETCHEN drives),
+//  - ends as soon as software writes a non-zero value to the soc_ctrl CORESTATUS register,
+//  - decodes UART TX on the pin and streams it to stdout.
+//
+// Usage: Vcroc_soc [--max-cycles N] [--baud-cycles N] [--expect N] [+trace...] <program>
+// The process exits with 0 if the return code equals --expect (default 1, see sw/crt0.S),
+// with 1 if it differs and with 2 on errors or a timeout.
+//
+// Waveforms are only available in the tracing build (make verilator-harness-trace) and are
+// dumped to an FST file inside a window of cycles selected at runtime:
+//   +trace                  dump the whole run
+//   +trace_start=<cycle>    open the window at a cycle
+//   +trace_pc=<addr>        open the window when the core decodes the instruction at addr
+//   +trace_write=<addr>     open the window when the core writes to addr
+//   +trace_end=<cycle>      close the window at a cycle
+//   +trace_cycles=<n>       close the window n cycles after it opened
+//   +trace_file=<path>      output file (default harness.fst)
+
+#include <elf.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Vcroc_soc.h"
+#include "verilated.h"
+#include "verilated_vpi.h"
+#if VM_TRACE
+#include "verilated_fst_c.h"
+#endif
+
+// Memory map, keep in sync with rtl/croc_pkg.sv
+// (-DNUM_SRAM_BANKS / -DSRAM_BANK_WORDS along with the +define+ of the same name)
+static const uint32_t SramBaseAddr     = 0x10000000;
+#ifdef NUM_SRAM_BANKS
+static const uint32_t NumSramBanks     = NUM_SRAM_BANKS;
+#else
+static const uint32_t NumSramBanks     = 2;
+#endif
+#ifdef SRAM_BANK_WORDS
+static const uint32_t SramBankNumWords = SRAM_BANK_WORDS;
+#else
+static const uint32_t SramBankNumWords = 512;
+#endif
+static const uint32_t SramNumWords     = NumSramBanks * SramBankNumWords;
+// croc_pkg::SramBankInterleave in bytes (0: contiguous banks), set by +define+SRAM_INTERLEAVE
+#ifdef SRAM_INTERLEAVE
+static const uint32_t SramBankInterleave = SRAM_INTERLEAVE;
+#else
+static const uint32_t SramBankInterleave = 0;
+#endif
+
+// Reference clock (32.768 kHz) relative to the 20 MHz system clock of tb_croc_soc
+static const uint64_t RefClkHalfPeriod = 305;
+
+// Default UART bit time in system clock cycles, TB_FREQUENCY / TB_BAUDRATE in sw/config.h
+static const uint32_t DefaultBaudCycles = 20000000 / 125000;
+
+static const char *const HierPrefixes[] = {"croc_soc.", "TOP.croc_soc."};
+
+//-------------------------------------------------------------------------------------------------
+// Program image
+//-------------------------------------------------------------------------------------------------
+
+struct Image {
+    std::vector<uint32_t> words = std::vector<uint32_t>(SramNumWords, 0);
+    std::vector<bool> valid     = std::vector<bool>(SramNumWords, false);
+
+    bool put(uint32_t addr, uint8_t byte) {
+        if (addr < SramBaseAddr || addr >= SramBaseAddr + 4 * SramNumWords) {
+            fprintf(stderr, "[HARNESS] Address 0x%08x is outside of the SRAM\n", addr);
+            return false;
+        }
+        uint32_t word  = (addr - SramBaseAddr) / 4;
+        uint32_t shift = 8 * (addr % 4);
+        words[word]    = (words[word] & ~(0xFFu << shift)) | (uint32_t(byte) << shift);
+        valid[word]    = true;
+        return true;
+    }
+};
+
+static bool load_elf(const std::vector<char> &file, Image &image) {
+    if (file.size() < sizeof(Elf32_Ehdr)) return false;
+    const Elf32_Ehdr *ehdr = reinterpret_cast<const Elf32_Ehdr *>(file.data());
+    if (ehdr->e_ident[EI_CLASS] != ELFCLASS32 || ehdr->e_machine != EM_RISCV) {
+        fprintf(stderr, "[HARNESS] Not a 32-bit RISC-V ELF file\n");
+        return false;
+    }
+    for (unsigned i = 0; i < ehdr->e_phnum; i++) {
+        size_t off = ehdr->e_phoff + i * ehdr->e_phentsize;
+        if (off + sizeof(Elf32_Phdr) > file.size()) return false;
+        const Elf32_Phdr *phdr = reinterpret_cast<const Elf32_Phdr *>(file.data() + off);
+        if (phdr->p_type != PT_LOAD || phdr->p_filesz == 0) continue;
+        if (phdr->p_offset + phdr->p_filesz > file.size()) return false;
+        for (uint32_t b = 0; b < phdr->p_filesz; b++) {
+            if (!image.put(phdr->p_paddr + b, file[phdr->p_offset + b])) return false;
+        }
+    }
+    return true;
+}
+
+static bool load_hex(const std::vector<char> &file, Image &image) {
+    std::istringstream in(std::string(file.begin(), file.end()));
+    std::string token;
+    uint32_t addr = 0;
+    while (in >> token) {
+        if (token[0] == '@') {
+            addr = std::strtoul(token.c_str() + 1, nullptr, 16);
+        } else {
+            if (!image.put(addr++, std::strtoul(token.c_str(), nullptr, 16))) return false;
+        }
+    }
+    return true;
+}
+
+static bool load_program(const char *path, Image &image) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        fprintf(stderr, "[HARNESS] Failed to open %s\n", path);
+        return false;
+    }
+    std::vector<char> file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (file.size() >= 4 && std::memcmp(file.data(), ELFMAG, SELFMAG) == 0) {
+        return load_elf(file, image);
+    }
+    return load_hex(file, image);
+}
+
+//-------------------------------------------------------------------------------------------------
+// VPI backdoor
+//-------------------------------------------------------------------------------------------------
+
+static vpiHandle find_signal(const std::string &path) {
+    for (const char *prefix : HierPrefixes) {
+        std::string name = prefix + path;
+        vpiHandle h      = vpi_handle_by_name(const_cast<PLI_BYTE8 *>(name.c_str()), nullptr);
+        if (h) return h;
+    }
+    fprintf(stderr, "[HARNESS] Signal croc_soc.%s not found (see harness.vlt)\n", path.c_str());
+    return nullptr;
+}
+
+// SRAM bank and row holding a word, keep in sync with the bank mapping in rtl/croc_domain.sv
+static void sram_locate(uint32_t word, uint32_t &bank, uint32_t &row) {
+    if (SramBankInterleave == 0) {
+        bank = word / SramBankNumWords;
+        row  = word % SramBankNumWords;
+    } else {
+        // same bit permutation as croc_pkg::sram_bank_remap, in words
+        uint32_t lsb   = 0;
+        while ((4u << lsb) < SramBankInterleave) lsb++;
+        uint32_t low   = word & ((1u << lsb) - 1);
+        bank = (word >> lsb) % NumSramBanks;
+        row  = ((word >> lsb) / NumSramBanks << lsb) | low;
+    }
+}
+
+static bool preload_sram(const Image &image) {
+    vpiHandle banks[NumSramBanks];
+    for (uint32_t b = 0; b < NumSramBanks; b++) {
+        banks[b] = find_signal("i_croc.gen_sram_bank[" + std::to_string(b) +
+                               "].i_sram.i_tc_sram.sram");
+        if (!banks[b]) return false;
+    }
+    uint32_t loaded = 0;
+    for (uint32_t w = 0; w < SramNumWords; w++) {
+        if (!image.valid[w]) continue;
+        uint32_t bank, row;
+        sram_locate(w, bank, row);
+        vpiHandle elem = vpi_handle_by_index(banks[bank], row);
+        if (!elem) {
+            fprintf(stderr, "[HARNESS] SRAM bank %u has no row %u\n", bank, row);
+            return false;
+        }
+        s_vpi_value val;
+        val.format        = vpiIntVal;
+        val.value.integer = image.words[w];
+        vpi_put_value(elem, &val, nullptr, vpiNoDelay);
+        loaded++;
+    }
+    printf("[HARNESS] Preloaded 0x%x words into the SRAM\n", loaded);
+    return true;
+}
+
+// CORESTATUS occupies bits [33:2] of soc_ctrl_reg2hw_t (see rtl/soc_ctrl/soc_ctrl_reg_pkg.sv)
+static uint32_t read_corestatus(vpiHandle reg2hw) {
+    s_vpi_value val;
+    val.format = vpiVectorVal;
+    vpi_get_value(reg2hw, &val);
+    uint32_t lo = val.value.vector[0].aval;
+    uint32_t hi = val.value.vector[1].aval;
+    return (lo >> 2) | (hi << 30);
+}
+
+//-------------------------------------------------------------------------------------------------
+// UART receiver (8N1, sampled in the middle of each bit)
+//-------------------------------------------------------------------------------------------------
+
+struct UartRx {
+    uint32_t baud_cycles;
+    uint32_t count = 0;
+    int bit        = -1; // -1: idle, 0-7: data bits, 8: stop bit
+    uint8_t data   = 0;
+    bool last      = true;
+
+    void tick(bool tx) {
+        if (bit < 0) {
+            if (last && !tx) { // start bit
+                bit   = 0;
+                count = baud_cycles + baud_cycles / 2;
+                data  = 0;
+            }
+        } else if (--count == 0) {
+            if (bit < 8) {
+                data |= uint8_t(tx) << bit;
+                bit++;
+                count = baud_cycles;
+            } else {
+                if (!tx) fprintf(stderr, "[HARNESS] UART framing error\n");
+                putchar(data);
+                if (data == '\n') fflush(stdout);
+                bit = -1;
+            }
+        }
+        last = tx;
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+// Runtime-windowed tracing
+//-------------------------------------------------------------------------------------------------
+
+// returns true if +<name>=<value> was given and stores value
+static bool plusarg(VerilatedContext *contextp, const char *name, uint64_t &value) {
+    std::string match = contextp->commandArgsPlusMatch(name);
+    size_t len        = std::strlen(name);
+    if (match.size() <= len + 1 || match[len + 1] != '=') return false;
+    value = std::strtoull(match.c_str() + len + 2, nullptr, 0);
+    return true;
+}
+
+struct TraceWindow {
+    bool requested    = false; // any trace option given
+    uint64_t start    = 0;
+    uint64_t end      = UINT64_MAX;
+    uint64_t length   = UINT64_MAX;
+    bool pc_trigger   = false;
+    bool wr_trigger   = false;
+    uint64_t pc       = 0;
+    uint64_t wr_addr  = 0;
+    std::string file  = "harness.fst";
+    bool open         = false;
+    bool done         = false;
+    uint64_t opened   = 0;
+    vpiHandle pc_id   = nullptr;
+    vpiHandle data_req, data_we, data_addr;
+
+    bool parse(VerilatedContext *contextp) {
+        requested = std::string(contextp->commandArgsPlusMatch("trace")) == "+trace";
+        requested |= plusarg(contextp, "trace_start", start);
+        requested |= plusarg(contextp, "trace_end", end);
+        requested |= plusarg(contextp, "trace_cycles", length);
+        pc_trigger = plusarg(contextp, "trace_pc", pc);
+        wr_trigger = plusarg(contextp, "trace_write", wr_addr);
+        requested |= pc_trigger | wr_trigger;
+        std::string match = contextp->commandArgsPlusMatch("trace_file=");
+        if (!match.empty()) file = match.substr(std::strlen("+trace_file="));
+        return requested;
+    }
+
+    bool bind() {
+        if (pc_trigger && !(pc_id = find_signal("i_croc.i_core_wrap.i_ibex.pc_id"))) return false;
+        if (wr_trigger) {
+            data_req  = find_signal("i_croc.i_core_wrap.data_req_o");
+            data_we   = find_signal("i_croc.i_core_wrap.data_we_o");
+            data_addr = find_signal("i_croc.i_core_wrap.data_addr_o");
+            if (!data_req || !data_we || !data_addr) return false;
+        }
+        return true;
+    }
+
+    static uint32_t read(vpiHandle h) {
+        s_vpi_value val;
+        val.format = vpiIntVal;
+        vpi_get_value(h, &val);
+        return val.value.integer;
+    }
+
+    bool triggered(uint64_t cycle) {
+        if (pc_trigger || wr_trigger) {
+            if (cycle < start) return false;
+            if (pc_trigger && read(pc_id) == pc) return true;
+            if (wr_trigger && read(data_req) && read(data_we) && read(data_addr) == wr_addr)
+                return true;
+            return false;
+        }
+        return cycle >= start;
+    }
+
+    // evaluated once per cycle, returns true while waveforms should be dumped
+    bool update(uint64_t cycle) {
+        if (!requested || done) return false;
+        if (!open && triggered(cycle)) {
+            open   = true;
+            opened = cycle;
+            printf("[HARNESS] Trace window opened at cycle 0x%llx\n", (unsigned long long)cycle);
+        }
+        if (open && (cycle >= end || cycle - opened >= length)) {
+            open = false;
+            done = true;
+            printf("[HARNESS] Trace window closed at cycle 0x%llx\n", (unsigned long long)cycle);
+        }
+        return open;
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+// Main
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+    uint64_t max_cycles  = 100000000;
+    uint32_t baud_cycles = DefaultBaudCycles;
+    uint32_t expect      = 1;
+    const char *program  = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--max-cycles") && i + 1 < argc) {
+            max_cycles = std::strtoull(argv[++i], nullptr, 0);
+        } else if (!std::strcmp(argv[i], "--baud-cycles") && i + 1 < argc) {
+            baud_cycles = std::strtoul(argv[++i], nullptr, 0);
+        } else if (!std::strcmp(argv[i], "--expect") && i + 1 < argc) {
+            expect = std::strtoul(argv[++i], nullptr, 0);
+        } else if (argv[i][0] != '-' && argv[i][0] != '+') {
+            program = argv[i];
+        }
+    }
+    if (!program) {
+        fprintf(stderr, "Usage: %s [--max-cycles N] [--baud-cycles N] [--expect N] <program>\n",
+                argv[0]);
+        return 2;
+    }
+
+    Image image;
+    if (!load_program(program, image)) return 2;
+
+    VerilatedContext *contextp = new VerilatedContext;
+    contextp->commandArgs(argc, argv);
+    TraceWindow trace;
+    trace.parse(contextp);
+#if VM_TRACE
+    contextp->traceEverOn(true);
+#endif
+    Vcroc_soc *top = new Vcroc_soc{contextp};
+
+#if VM_TRACE
+    VerilatedFstC *tfp = nullptr;
+    if (trace.requested) {
+        tfp = new VerilatedFstC;
+        top->trace(tfp, 99);
+        tfp->open(trace.file.c_str());
+    }
+#else
+    if (trace.requested) {
+        fprintf(stderr, "[HARNESS] Tracing requested but not built in, "
+                        "use make verilator-harness-trace\n");
+    }
+#endif
+
+    uint64_t cycle = 0;
+#if VM_TRACE
+    bool dump = false;
+#endif
+    auto step = [&]() {
+        top->clk_i = 0;
+        top->eval();
+#if VM_TRACE
+        if (dump) tfp->dump(contextp->time());
+#endif
+        contextp->timeInc(1);
+        top->clk_i = 1;
+        if (cycle % RefClkHalfPeriod == 0) top->ref_clk_i = !top->ref_clk_i;
+        top->eval();
+#if VM_TRACE
+        if (dump) tfp->dump(contextp->time());
+#endif
+        contextp->timeInc(1);
+        cycle++;
+    };
+
+    // debug module held in reset, UART receive line idle
+    top->rst_ni       = 0;
+    top->ref_clk_i    = 0;
+    top->testmode_i   = 0;
+    top->fetch_en_i   = 0;
+    top->bootmode_i   = 0; // JTAG boot, the SRAM is preloaded
+    top->jtag_tck_i   = 0;
+    top->jtag_tdi_i   = 0;
+    top->jtag_tms_i   = 0;
+    top->jtag_trst_ni = 0;
+    top->uart_rx_i    = 1;
+    top->gpio_i       = 0;
+    for (int i = 0; i < 4; i++) step();
+    top->rst_ni = 1;
+    for (int i = 0; i < 4; i++) step();
+
+    vpiHandle reg2hw = find_signal("i_croc.i_soc_ctrl.reg2hw");
+    if (!reg2hw || !preload_sram(image)) return 2;
+#if VM_TRACE
+    if (trace.requested && !trace.bind()) return 2;
+#endif
+
+    top->fetch_en_i = 1;
+    UartRx uart{baud_cycles};
+    uint32_t exit_code = 0;
+    auto t_start       = std::chrono::steady_clock::now();
+    while (cycle < max_cycles && !contextp->gotFinish()) {
+#if VM_TRACE
+        dump = trace.update(cycle);
+#endif
+        step();
+        // loop back the lowest four outputs to GPIO 7:4, as in tb_croc_soc
+        top->gpio_i = (top->gpio_out_en_o & top->gpio_o & 0xF) << 4;
+        uart.tick(top->uart_tx_o);
+        exit_code = read_corestatus(reg2hw);
+        if (exit_code != 0) break;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t_start;
+    fflush(stdout);
+
+    top->final();
+#if VM_TRACE
+    if (tfp) {
+        tfp->close();
+        delete tfp;
+    }
+#endif
+    delete top;
+    delete contextp;
+
+    printf("[HARNESS] Simulated %llu cycles in %.2f s (%.0f cycles/s)\n",
+           (unsigned long long)cycle, elapsed.count(),
+           elapsed.count() > 0 ? cycle / elapsed.count() : 0.0);
+
+    if (exit_code == 0) {
+        printf("[HARNESS] Timeout after 0x%llx cycles\n", (unsigned long long)cycle);
+        return 2;
+    }
+    printf("[HARNESS] Simulation finished: return code 0x%x after 0x%llx cycles\n", exit_code,
+           (unsigned long long)cycle);
+    return (exit_code == expect) ? 0 : 1;
+}
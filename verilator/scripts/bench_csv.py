@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Collects the BENCH result lines (see sw/lib/inc/bench.h) from simulation logs into a CSV file.
+# Usage: bench_csv.py [--revision REV] <log> [<log> ...] > results.csv
+
+import argparse
+import csv
+import os
+import re
+import sys
+
+# tb_croc_soc prefixes every UART line with "@<time> | [UART] ", the C++ harness prints it as is
+BENCH_RE = re.compile(r"(?:^|\[UART\] )BENCH,([^,\s]+),((?:[0-9A-Fa-f]+,){5}[0-9A-Fa-f]+)")
+EXIT_RE  = re.compile(r"Simulation finished: return code 0x([0-9A-Fa-f]+)")
+
+FIELDS = ["revision", "program", "kernel", "reps", "cycles_min", "cycles_median",
+          "instret_min", "instret_median", "cpi", "exit_code"]
+
+
+def parse_log(path):
+    rows = []
+    exit_code = None
+    with open(path, errors="replace") as f:
+        for line in f:
+            m = BENCH_RE.search(line)
+            if m:
+                values = [int(v, 16) for v in m.group(2).split(",")]
+                rows.append([m.group(1)] + values)
+                continue
+            m = EXIT_RE.search(line)
+            if m:
+                exit_code = int(m.group(1), 16)
+    return rows, exit_code
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--revision", default="", help="revision label stored in every row")
+    parser.add_argument("logs", nargs="+", help="simulation logs, one per benchmark program")
+    args = parser.parse_args()
+
+    writer = csv.writer(sys.stdout)
+    writer.writerow(FIELDS)
+    failed = False
+    for log in args.logs:
+        program = os.path.splitext(os.path.basename(log))[0]
+        rows, exit_code = parse_log(log)
+        # programs return 1 on success, see sw/crt0.S
+        if not rows or exit_code != 1:
+            print(f"{log}: no results or failed (return code {exit_code})", file=sys.stderr)
+            failed = True
+        for kernel, reps, cyc_min, cyc_med, ins_min, ins_med, cpi_x1000 in rows:
+            writer.writerow([args.revision, program, kernel, reps, cyc_min, cyc_med,
+                             ins_min, ins_med, f"{cpi_x1000 / 1000:.3f}", exit_code])
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Regression runner: simulates every program of sw/bin in parallel, one simulator process per
+# program, and checks the CORESTATUS return code and (if present) the golden UART output.
+# Usage: regress.py [--sims harness,verilator,vsim] [-j N] [--junit FILE] [--csv FILE] [programs]
+
+import argparse
+import concurrent.futures
+import csv
+import os
+import re
+import subprocess
+import sys
+import time
+from xml.sax.saxutils import escape, quoteattr
+
+PROJ_DIR = os.path.realpath(os.path.join(os.path.dirname(__file__), "..", ".."))
+
+# tb_croc_soc prints "@<time> | [UART] <line>", the C++ harness prints the UART output as is
+TB_UART_RE   = re.compile(r"^@\s*\S+\s*\|\s*\[UART\] (.*)$")
+EXIT_RE      = re.compile(r"Simulation finished: return code 0x([0-9A-Fa-f]+)")
+CYCLES_RE    = re.compile(r"return code 0x[0-9A-Fa-f]+ after 0x([0-9A-Fa-f]+) cycles")
+HARNESS_RE   = re.compile(r"^\[HARNESS\] ")
+
+FIELDS = ["program", "sim", "status", "exit_code", "uart", "cycles", "wall_s"]
+
+
+def sim_command(sim, args, hex_path, work_dir):
+    """Command line and working directory of one simulation."""
+    if sim == "harness":
+        return [args.harness, "--max-cycles", str(args.max_cycles), hex_path], work_dir
+    if sim == "verilator":
+        return [args.tb, f"+binary={hex_path}"], work_dir
+    if sim in ("vsim", "vsim-yosys"):
+        # the work library in vsim/ holds either the RTL or the netlist, see make vsim-compile
+        return [args.vsim, "-c", "-l", os.path.join(work_dir, "transcript"),
+                "-wlf", os.path.join(work_dir, "vsim.wlf"), "tb_croc_soc", "-t", "1ns",
+                "-suppress", "vsim-3009", "-suppress", "vsim-8683", "-suppress", "vsim-8386",
+                f"+binary={hex_path}", "-do", "run -all; quit -f"], os.path.join(PROJ_DIR, "vsim")
+    raise ValueError(f"unknown simulator {sim}")
+
+
+def uart_lines(sim, log):
+    """UART output of a simulation log, without the simulator decoration."""
+    lines = []
+    for line in log.splitlines():
+        if sim == "harness":
+            if not HARNESS_RE.match(line):
+                lines.append(line)
+        else:
+            m = TB_UART_RE.match(line)
+            if m:
+                lines.append(m.group(1))
+    return lines
+
+
+def golden_match(lines, golden):
+    """UART lines against a golden file, a '*' in a golden line matches any text."""
+    if len(lines) != len(golden):
+        return False
+    return all(re.fullmatch(".*".join(map(re.escape, expected.split("*"))), line)
+               for line, expected in zip(lines, golden))
+
+
+def run_one(sim, program, args):
+    work_dir = os.path.join(args.out_dir, sim, program)
+    os.makedirs(work_dir, exist_ok=True)
+    hex_path = os.path.join(args.bin_dir, program + ".hex")
+    cmd, cwd = sim_command(sim, args, hex_path, work_dir)
+
+    result = dict(program=program, sim=sim, status="pass", exit_code="", uart="", cycles="",
+                  wall_s=0.0, message="")
+    t_start = time.monotonic()
+    try:
+        proc = subprocess.run(cmd, cwd=cwd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                              timeout=args.timeout, errors="replace")
+        log = proc.stdout
+    except subprocess.TimeoutExpired as e:
+        log = e.stdout.decode(errors="replace") if isinstance(e.stdout, bytes) else (e.stdout or "")
+        result["status"]  = "timeout"
+        result["message"] = f"killed after {args.timeout} s"
+    except OSError as e:
+        log = ""
+        result["status"]  = "error"
+        result["message"] = str(e)
+    result["wall_s"] = round(time.monotonic() - t_start, 2)
+
+    with open(os.path.join(work_dir, "sim.log"), "w") as f:
+        f.write(log)
+
+    m = EXIT_RE.search(log)
+    if m:
+        result["exit_code"] = int(m.group(1), 16)
+    m = CYCLES_RE.search(log)
+    if m:
+        result["cycles"] = int(m.group(1), 16)
+
+    if result["status"] == "pass":
+        if result["exit_code"] == "":
+            result["status"]  = "timeout"
+            result["message"] = "no return code (CORESTATUS never written)"
+        elif result["exit_code"] != args.expect:
+            result["status"]  = "fail"
+            result["message"] = f"return code 0x{result['exit_code']:x}, expected 0x{args.expect:x}"
+
+    uart = uart_lines(sim, log)
+    golden = os.path.join(args.golden_dir, program + ".uart")
+    expected = None
+    if os.path.exists(golden):
+        with open(golden, errors="replace") as f:
+            expected = f.read().splitlines()
+    # a matching golden file is kept as is, it may hold wildcards
+    if args.update_golden and result["status"] == "pass" and \
+            not (expected is not None and golden_match(uart, expected)):
+        with open(golden, "w") as f:
+            f.write("\n".join(uart) + "\n")
+        result["uart"] = "updated"
+    elif expected is not None:
+        if golden_match(uart, expected):
+            result["uart"] = "match"
+        else:
+            result["uart"] = "mismatch"
+            if result["status"] == "pass":
+                result["status"]  = "fail"
+                result["message"] = f"UART output differs from {os.path.relpath(golden, PROJ_DIR)}"
+    return result
+
+
+def write_junit(path, results):
+    failures = sum(r["status"] == "fail" for r in results)
+    errors   = sum(r["status"] in ("timeout", "error") for r in results)
+    with open(path, "w") as f:
+        f.write('<?xml version="1.0" encoding="UTF-8"?>\n')
+        f.write(f'<testsuite name="croc-regression" tests="{len(results)}" '
+                f'failures="{failures}" errors="{errors}">\n')
+        for r in results:
+            f.write(f'  <testcase classname={quoteattr(r["sim"])} name={quoteattr(r["program"])} '
+                    f'time="{r["wall_s"]}">\n')
+            if r["status"] == "fail":
+                f.write(f'    <failure message={quoteattr(r["message"])}/>\n')
+            elif r["status"] != "pass":
+                f.write(f'    <error type="{r["status"]}" message={quoteattr(r["message"])}/>\n')
+            log = os.path.join(r["sim"], r["program"], "sim.log")
+            f.write(f'    <system-out>{escape(log)}</system-out>\n')
+            f.write('  </testcase>\n')
+        f.write('</testsuite>\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--sims", default="harness",
+                        help="comma separated list of harness, verilator, vsim, vsim-yosys")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count() or 1)
+    parser.add_argument("--timeout", type=float, default=600, help="wall time limit per run (s)")
+    parser.add_argument("--max-cycles", type=int, default=50000000, help="harness cycle limit")
+    parser.add_argument("--expect", type=lambda v: int(v, 0), default=1, help="return code")
+    parser.add_argument("--bin-dir", default=os.path.join(PROJ_DIR, "sw", "bin"))
+    parser.add_argument("--golden-dir", default=os.path.join(PROJ_DIR, "sw", "golden"))
+    parser.add_argument("--update-golden", action="store_true",
+                        help="store the UART output of passing runs as the new golden files")
+    parser.add_argument("--out-dir", default=os.path.join(PROJ_DIR, "verilator", "regress"))
+    parser.add_argument("--harness", default=os.path.join(PROJ_DIR, "verilator", "obj_harness",
+                                                          "Vcroc_soc"))
+    parser.add_argument("--tb", default=os.path.join(PROJ_DIR, "verilator", "obj_dir",
+                                                     "Vtb_croc_soc"))
+    parser.add_argument("--vsim", default="vsim")
+    parser.add_argument("--junit", help="write a JUnit XML summary")
+    parser.add_argument("--csv", help="write a CSV summary")
+    parser.add_argument("programs", nargs="*", help="program names (default: all in --bin-dir)")
+    args = parser.parse_args()
+
+    args.bin_dir = os.path.realpath(args.bin_dir)
+    args.out_dir = os.path.realpath(args.out_dir)
+    # simulations run in their own directories
+    args.harness = os.path.realpath(args.harness)
+    args.tb      = os.path.realpath(args.tb)
+    programs = args.programs or sorted(f[:-4] for f in os.listdir(args.bin_dir)
+                                       if f.endswith(".hex"))
+    sims = [s for s in args.sims.replace(" ", ",").split(",") if s]
+    if args.update_golden:
+        os.makedirs(args.golden_dir, exist_ok=True)
+
+    jobs = [(sim, prog) for sim in sims for prog in programs]
+    results = []
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(args.jobs, 1)) as pool:
+        futures = [pool.submit(run_one, sim, prog, args) for sim, prog in jobs]
+        for future in concurrent.futures.as_completed(futures):
+            r = future.result()
+            results.append(r)
+            detail = f" ({r['message']})" if r["message"] else ""
+            print(f"[{r['status'].upper():>7}] {r['sim']:<10} {r['program']:<24} "
+                  f"{r['wall_s']:8.2f} s{detail}", flush=True)
+
+    results.sort(key=lambda r: (r["sim"], r["program"]))
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=FIELDS, extrasaction="ignore")
+            writer.writeheader()
+            writer.writerows(results)
+    if args.junit:
+        write_junit(args.junit, results)
+
+    passed = sum(r["status"] == "pass" for r in results)
+    print(f"{passed}/{len(results)} simulations passed")
+    return 0 if passed == len(results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Turns the histogram of the sampling profiler (see sw/lib/inc/sprof.h) into a flat profile,
+# attributing every bucket to the functions of the ELF it overlaps.
+# Usage: sprof.py [--top N] <program.elf> <simulation log>
+
+import argparse
+import re
+import struct
+import sys
+
+# tb_croc_soc prefixes every UART line with "@<time> | [UART] ", the C++ harness prints it as is
+BEGIN_RE  = re.compile(r"(?:^|\[UART\] )SPROF_BEGIN,(pc|ra),((?:[0-9A-Fa-f]+,){5}[0-9A-Fa-f]+)")
+BUCKET_RE = re.compile(r"(?:^|\[UART\] )SPROF,([0-9A-Fa-f]+),([0-9A-Fa-f]+)")
+END_RE    = re.compile(r"(?:^|\[UART\] )SPROF_END")
+
+STT_FUNC = 2
+
+
+def read_functions(path):
+    """Function symbols of a 32 bit little endian ELF as a sorted list of (addr, size, name)."""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF" or elf[4] != 1 or elf[5] != 1:
+        sys.exit(f"{path}: not a 32 bit little endian ELF")
+    shoff, = struct.unpack_from("<I", elf, 0x20)
+    shentsize, shnum = struct.unpack_from("<HH", elf, 0x2E)
+
+    sections = [struct.unpack_from("<IIIIIIIIII", elf, shoff + i * shentsize)
+                for i in range(shnum)]
+    funcs = {}
+    for sec in sections:
+        if sec[1] != 2:  # SHT_SYMTAB
+            continue
+        strtab = sections[sec[6]]  # sh_link
+        for offs in range(sec[4], sec[4] + sec[5], 16):
+            name, value, size, info = struct.unpack_from("<IIIB", elf, offs)
+            if info & 0xF != STT_FUNC or value == 0:
+                continue
+            start = strtab[4] + name
+            label = elf[start:elf.index(b"\0", start)].decode(errors="replace")
+            funcs[value] = (value, size, label)
+    return sorted(funcs.values())
+
+
+def read_dump(path):
+    header, buckets = None, []
+    with open(path, errors="replace") as f:
+        for line in f:
+            m = BEGIN_RE.search(line)
+            if m:
+                mode = m.group(1)
+                base, width, period, samples, expected, outside = \
+                    (int(v, 16) for v in m.group(2).split(","))
+                header = dict(mode=mode, base=base, width=width, period=period,
+                              samples=samples, expected=expected, outside=outside)
+                buckets = []
+                continue
+            m = BUCKET_RE.search(line)
+            if m and header:
+                buckets.append((int(m.group(1), 16), int(m.group(2), 16)))
+                continue
+            if END_RE.search(line) and header:
+                return header, buckets
+    sys.exit(f"{path}: no complete SPROF dump found")
+
+
+def attribute(funcs, header, buckets):
+    """Split every bucket across the functions it overlaps, in proportion to the overlap."""
+    counts = {}
+    width = header["width"]
+    for addr, count in buckets:
+        end = addr + width
+        covered = 0
+        for fstart, fsize, name in funcs:
+            overlap = min(end, fstart + max(fsize, 1)) - max(addr, fstart)
+            if overlap > 0:
+                counts[name] = counts.get(name, 0) + count * overlap / width
+                covered += overlap
+        if covered < width:
+            counts["<unknown>"] = counts.get("<unknown>", 0) + count * (width - covered) / width
+    if header["outside"]:
+        counts["<outside sram>"] = header["outside"]
+    return counts
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--top", type=int, default=0, help="only print the N hottest functions")
+    parser.add_argument("elf")
+    parser.add_argument("log")
+    args = parser.parse_args()
+
+    funcs = read_functions(args.elf)
+    header, buckets = read_dump(args.log)
+    counts = attribute(funcs, header, buckets)
+    total = header["samples"]
+
+    what = "return address" if header["mode"] == "ra" else "pc"
+    print(f"# {total} samples of the {what} ({header['expected']} expected), "
+          f"one every {header['period']} cycles, {header['width']} byte buckets")
+    print(f"{'samples':>9} {'%':>6}  function")
+    rows = sorted(counts.items(), key=lambda kv: -kv[1])
+    if args.top:
+        rows = rows[:args.top]
+    for name, count in rows:
+        share = 100.0 * count / total if total else 0.0
+        print(f"{count:9.1f} {share:6.2f}  {name}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
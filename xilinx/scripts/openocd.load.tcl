@@ -0,0 +1,45 @@
+# Copyright 2024 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Fast program loading over the system bus of the debug module, sourced after an adapter and
+# target setup such as openocd.genesys2.tcl:
+#   openocd -f openocd.genesys2.tcl -f openocd.load.tcl -c "croc_load sw/bin/helloworld.elf; shutdown"
+#
+# With system bus access OpenOCD sets SBCS.sbautoincrement once and queues the SBData0 writes
+# of a block back to back, SBCS (sberror, sbbusyerror) is only checked at the end of the block.
+# Reports the TCK cycles per word (from the adapter speed, so an upper bound).
+
+proc croc_adapter_khz {} {
+    if {[catch {set khz [adapter speed]}]} {
+        set khz [adapter_khz]
+    }
+    return [lindex $khz end]
+}
+
+proc croc_load {image {entry 0x10000080}} {
+    # older OpenOCD versions only have prefer_sba
+    if {[catch {riscv set_mem_access sysbus}]} {
+        riscv set_prefer_sba on
+    }
+    halt
+
+    set start [clock microseconds]
+    set output [capture "load_image $image"]
+    set elapsed [expr {[clock microseconds] - $start}]
+    echo [string trim $output]
+
+    set bytes 0
+    foreach {match n} [regexp -all -inline {(\d+) bytes written} $output] {
+        incr bytes $n
+    }
+    if {$bytes > 0} {
+        set words [expr {($bytes + 3) / 4}]
+        set tck [expr {$elapsed * [croc_adapter_khz] / 1000}]
+        echo [format "loaded %d words in %.3f ms, %.1f TCK cycles per word" \
+            $words [expr {$elapsed / 1000.0}] [expr {double($tck) / $words}]]
+    }
+
+    resume $entry
+    echo [format "started at 0x%08x" $entry]
+}
@@ -0,0 +1,342 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Incremental synthesis: every module with kept hierarchy (keep_hierarchy_modules in
+# yosys_steps.tcl) and the top are synthesized on their own, in parallel, and the mapped
+# netlists are cached under a hash of their elaborated RTLIL and of the flow:
+#   1. elaborate the whole design once (yosys_incremental.tcl, INCR_STEP=elaborate)
+#   2. split it into one RTLIL file per block: the block, the submodules flattened into it and
+#      its kept submodules as blackboxes, with the auto-generated names numbered per block so
+#      the file (and its hash) only changes when the block itself changes
+#   3. synthesize the blocks missing in the cache (INCR_STEP=block)
+#   4. stitch the cached netlists together and run the final steps (INCR_STEP=stitch)
+# Blocks come from the cache or a fresh run alike, so the stitched netlist does not depend on
+# what was cached. Each block is optimized without its surroundings, as in the full flow.
+#
+# The stitched netlist is not byte-identical to the one of the full flow (yosys_synthesis.tcl):
+# the blocks are renumbered and mapped separately, so internal names and the ABC mapping can
+# differ. What is guaranteed is checked by --check REF with the netlist REF of the full flow
+# (INCR_STEP=check): both must be formally equivalent (equiv_make/equiv_simple/equiv_induct)
+# and their cell area must agree within --area-tolerance percent.
+#
+# Usage (from yosys/, environment as for yosys_synthesis.tcl):
+#   yosys_incremental.py [-j N] [--cache DIR] [--no-cache] [--yosys yosys]
+#                        [--check REF [--area-tolerance PERCENT]]
+
+import argparse
+import concurrent.futures
+import hashlib
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import time
+
+YOSYS_DIR  = os.path.realpath(os.path.join(os.path.dirname(__file__), ".."))
+SCRIPT     = os.path.join(YOSYS_DIR, "scripts", "yosys_incremental.tcl")
+# everything the netlist of a block depends on besides its RTLIL and the liberty files
+FLOW_DIRS  = ["scripts", "src"]
+
+LIB_CELL_RE = re.compile(rb"^\s*cell\s*\(\s*\"?([^\")\s]+)\"?\s*\)", re.M)
+PRIVATE_RE  = re.compile(r"\$(\d+)(?![\d\\])")
+
+
+class Module:
+    """One module of an RTLIL file, split into its attributes and body lines."""
+    def __init__(self, name, attrs):
+        self.name     = name
+        self.attrs    = attrs
+        self.lines    = []
+        self.cells    = []  # (type, keep_hierarchy) of all cells
+        self.blackbox = any(a.split()[1] == "\\blackbox" for a in attrs)
+
+    def text(self, drop_attrs=()):
+        attrs = [a for a in self.attrs if a.split()[1] not in drop_attrs]
+        return "\n".join(attrs + [f"module {self.name}"] + self.lines + ["end"]) + "\n"
+
+    def stub(self):
+        """the module as a blackbox: only its port wires"""
+        ports = [l for l in self.lines if l.lstrip().startswith("wire ")
+                 and {"input", "output", "inout"} & set(l.split()[1:-1])]
+        return "\n".join(["attribute \\blackbox 1", f"module {self.name}"] + ports + ["end"]) + "\n"
+
+
+def parse_rtlil(path):
+    """modules of an RTLIL file by name (with the leading backslash) in file order"""
+    modules = {}
+    module  = None
+    attrs   = []
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if module is None:
+                if line.startswith("attribute "):
+                    attrs.append(line)
+                elif line.startswith("module "):
+                    module = Module(line.split()[1], attrs)
+                    attrs  = []
+                continue
+            if line == "end":
+                modules[module.name] = module
+                module = None
+                continue
+            # attributes belong to the object (wire, cell, ...) on the line after them
+            module.lines.append(line)
+            stripped = line.lstrip()
+            if stripped.startswith("attribute "):
+                attrs.append(stripped)
+                continue
+            if stripped.startswith("cell "):
+                keep = any(a.split()[1] == "\\keep_hierarchy" and a.split()[2] != "0"
+                           for a in attrs)
+                module.cells.append((stripped.split()[1], keep))
+            attrs = []
+    return modules
+
+
+def normalize(text):
+    """numbers the auto-generated ($...$<n>) names in order of appearance, returns the text and
+    the next free number (the autoidx the file needs)"""
+    numbers = {}
+
+    def renumber(m):
+        return "$" + str(numbers.setdefault(m.group(1), len(numbers) + 1))
+
+    out = []
+    for line in text.splitlines():
+        tokens = line.split(" ")
+        out.append(" ".join(PRIVATE_RE.sub(renumber, t) if t.startswith("$") else t
+                            for t in tokens))
+    return "\n".join(out) + "\n", len(numbers) + 1
+
+
+def block_text(modules, block, kept, lib_cells):
+    """RTLIL of a block: the block, the submodules it flattens and its kept submodules as stubs"""
+    parts, seen, todo = [], {block}, [block]
+    while todo:
+        name = todo.pop(0)
+        mod  = modules[name]
+        if name != block and name in kept:
+            parts.append(mod.stub())
+            continue
+        parts.append(mod.text(drop_attrs=("\\top",)))
+        for cell_type, _ in mod.cells:
+            if cell_type in modules and cell_type not in seen and cell_type[1:] not in lib_cells:
+                seen.add(cell_type)
+                todo.append(cell_type)
+    text, next_idx = normalize("".join(parts))
+    return f"autoidx {next_idx}\n" + text
+
+
+def safe_name(name):
+    return re.sub(r"[^A-Za-z0-9_.-]", "_", name.lstrip("\\"))
+
+
+def sha256_file(h, path):
+    with open(path, "rb") as f:
+        for chunk in iter(lambda: f.read(1 << 20), b""):
+            h.update(chunk)
+
+
+def run_yosys(args, step, log, **env):
+    with open(log, "w") as f:
+        proc = subprocess.run([args.yosys, "-c", SCRIPT], cwd=YOSYS_DIR, stdout=f,
+                              stderr=subprocess.STDOUT,
+                              env=dict(os.environ, INCR_STEP=step, **env))
+    if proc.returncode != 0:
+        raise RuntimeError(f"yosys {step} failed, see {log}")
+
+
+def synth_block(args, name, key, block_file):
+    """synthesizes one block into its cache entry, returns the wall time"""
+    entry = os.path.join(args.cache, key)
+    work  = f"{entry}.tmp{os.getpid()}"
+    shutil.rmtree(work, ignore_errors=True)
+    for sub in ("reports", "tmp"):
+        os.makedirs(os.path.join(work, sub))
+    t_start = time.monotonic()
+    design = os.path.join(work, "tmp", "design.il")
+    run_yosys(args, "block", os.path.join(work, "yosys.log"), BLOCK_NAME=name[1:],
+              BLOCK_PREFIX=safe_name(name), BLOCK_IN=block_file, BLOCK_OUT=design,
+              TMP=os.path.join(work, "tmp"), REPORTS=os.path.join(work, "reports"))
+
+    # keep only the block itself, its kept submodules are blocks of their own
+    with open(design) as f:
+        autoidx = next(l for l in f if l.startswith("autoidx "))
+    with open(os.path.join(work, "netlist.il"), "w") as f:
+        f.write(autoidx + parse_rtlil(design)[name].text(drop_attrs=("\\top",)))
+    shutil.rmtree(os.path.join(work, "tmp"))
+
+    if args.no_cache:
+        shutil.rmtree(entry, ignore_errors=True)
+    try:
+        os.rename(work, entry)
+    except OSError:  # synthesized by a concurrent run in the meantime
+        shutil.rmtree(work, ignore_errors=True)
+    return time.monotonic() - t_start
+
+
+def check_netlist(args, top_design, rep_dir, log, netlist):
+    """compares the stitched netlist against args.check, returns 0 if it passes"""
+    failed = False
+    try:
+        run_yosys(args, "check", log, CHECK_GOLD=os.path.realpath(args.check),
+                  CHECK_GATE=netlist)
+    except RuntimeError:
+        # the stat reports are written before the equivalence check, compare them anyway
+        failed = True
+
+    stats = {}
+    for design in ("gold", "gate"):
+        path = os.path.join(rep_dir, f"{top_design}_check_{design}.json")
+        if not os.path.exists(path):
+            print(f"check failed before the cell statistics, see {log}")
+            return 1
+        with open(path) as f:
+            stats[design] = json.load(f)["design"]
+    gold, gate = stats["gold"], stats["gate"]
+
+    print(f"{'':<24} {'full flow':>14} {'incremental':>14}")
+    print(f"{'cells':<24} {gold['num_cells']:>14} {gate['num_cells']:>14}")
+    print(f"{'area':<24} {gold.get('area', 0):>14.1f} {gate.get('area', 0):>14.1f}")
+    gold_types = gold.get("num_cells_by_type", {})
+    gate_types = gate.get("num_cells_by_type", {})
+    for cell in sorted(set(gold_types) | set(gate_types)):
+        if gold_types.get(cell, 0) != gate_types.get(cell, 0):
+            print(f"  {cell:<22} {gold_types.get(cell, 0):>14} {gate_types.get(cell, 0):>14}")
+
+    if gold.get("area"):
+        delta = 100 * abs(gate.get("area", 0) - gold["area"]) / gold["area"]
+        if delta > args.area_tolerance:
+            print(f"cell area differs by {delta:.2f} % (tolerance {args.area_tolerance} %)")
+            failed = True
+    if failed:
+        print(f"check FAILED, see {log}")
+        return 1
+    print(f"netlists are equivalent, see {rep_dir}/{top_design}_check_equiv.rpt")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count(),
+                        help="blocks synthesized in parallel")
+    parser.add_argument("--cache", default=os.path.join(YOSYS_DIR, "cache"))
+    parser.add_argument("--no-cache", action="store_true",
+                        help="synthesize all blocks again and replace their cache entries")
+    parser.add_argument("--yosys", default="yosys")
+    parser.add_argument("--check", metavar="REF",
+                        help="check the stitched netlist against the netlist REF of the full flow")
+    parser.add_argument("--area-tolerance", type=float, default=1.0, metavar="PERCENT",
+                        help="largest cell area difference --check accepts")
+    args = parser.parse_args()
+
+    top_design = os.environ.get("TOP_DESIGN", "croc_chip")
+    tmp_dir    = os.path.realpath(os.environ.get("TMP", os.path.join(YOSYS_DIR, "tmp")))
+    out_dir    = os.path.realpath(os.environ.get("OUT", os.path.join(YOSYS_DIR, "out")))
+    rep_dir    = os.path.realpath(os.environ.get("REPORTS", os.path.join(YOSYS_DIR, "reports")))
+    incr_dir   = os.path.join(tmp_dir, "incr")
+    args.cache = os.path.realpath(args.cache)
+    shutil.rmtree(incr_dir, ignore_errors=True)
+    for d in (incr_dir, rep_dir, args.cache):
+        os.makedirs(d, exist_ok=True)
+
+    t_start = time.monotonic()
+    run_yosys(args, "elaborate", os.path.join(incr_dir, "elaborate.log"), INCR_DIR=incr_dir)
+    print(f"elaborated in {time.monotonic() - t_start:.1f} s", flush=True)
+
+    flow = hashlib.sha256()
+    flow.update(subprocess.run([args.yosys, "-V"], stdout=subprocess.PIPE).stdout)
+    for flow_dir in FLOW_DIRS:
+        for path in sorted(os.listdir(os.path.join(YOSYS_DIR, flow_dir))):
+            path = os.path.join(YOSYS_DIR, flow_dir, path)
+            if os.path.isfile(path):
+                sha256_file(flow, path)
+    lib_cells = set()
+    with open(os.path.join(incr_dir, "liberty.txt")) as f:
+        libs = [os.path.join(YOSYS_DIR, l.strip()) for l in f if l.strip()]
+    for lib in libs:
+        sha256_file(flow, lib)
+        with open(lib, "rb") as f:
+            lib_cells.update(c.decode() for c in LIB_CELL_RE.findall(f.read()))
+
+    modules = parse_rtlil(os.path.join(incr_dir, "elaborated.il"))
+    kept    = {t for m in modules.values() for t, keep in m.cells
+               if keep and t in modules and not modules[t].blackbox}
+    top     = "\\" + top_design
+    blocks  = sorted(kept | {top})
+
+    # blackboxes that are not liberty cells (e.g. tc_sram_blackbox) are read before the blocks
+    boxes = [m.text() for n, m in modules.items() if m.blackbox and n[1:] not in lib_cells]
+    stitch_files = []
+    if boxes:
+        stitch_files.append(os.path.join(incr_dir, "blackboxes.il"))
+        with open(stitch_files[0], "w") as f:
+            f.write("".join(boxes))
+
+    keys, missing = {}, []
+    for name in blocks:
+        text = block_text(modules, name, kept, lib_cells)
+        h = flow.copy()
+        h.update(text.encode())
+        keys[name] = h.hexdigest()[:32]
+        block_file = os.path.join(incr_dir, safe_name(name) + ".il")
+        with open(block_file, "w") as f:
+            f.write(text)
+        if args.no_cache or not os.path.exists(os.path.join(args.cache, keys[name], "netlist.il")):
+            missing.append((name, block_file))
+
+    print(f"{len(blocks)} blocks, {len(blocks) - len(missing)} cached, "
+          f"{len(missing)} to synthesize ({args.jobs} in parallel)", flush=True)
+    failed = False
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(args.jobs, 1)) as pool:
+        futures = {pool.submit(synth_block, args, name, keys[name], block_file): name
+                   for name, block_file in missing}
+        for future in concurrent.futures.as_completed(futures):
+            try:
+                print(f"  {futures[future][1:]:<64} {future.result():8.1f} s", flush=True)
+            except RuntimeError as e:
+                print(f"  {futures[future][1:]:<64} FAILED: {e}", flush=True)
+                failed = True
+    if failed:
+        return 1
+
+    # per-block reports; the register and instance lists of all blocks form the full ones
+    block_reps = os.path.join(rep_dir, "blocks")
+    shutil.rmtree(block_reps, ignore_errors=True)
+    os.makedirs(block_reps)
+    merged = {"registers": [], "instances": []}
+    for name in blocks:
+        entry = os.path.join(args.cache, keys[name])
+        stitch_files.append(os.path.join(entry, "netlist.il"))
+        for rpt in sorted(os.listdir(os.path.join(entry, "reports"))):
+            shutil.copy(os.path.join(entry, "reports", rpt), block_reps)
+        for kind, lines in merged.items():
+            with open(os.path.join(entry, "reports", f"{safe_name(name)}_{kind}.rpt")) as f:
+                lines.extend(l for l in f.read().splitlines() if l)
+    for kind, lines in merged.items():
+        with open(os.path.join(rep_dir, f"{top_design}_{kind}.rpt"), "w") as f:
+            f.write("".join(l + "\n" for l in lines))
+
+    stitch_list = os.path.join(incr_dir, "stitch.txt")
+    with open(stitch_list, "w") as f:
+        f.write("".join(p + "\n" for p in stitch_files))
+    run_yosys(args, "stitch", os.path.join(incr_dir, "stitch.log"), STITCH_LIST=stitch_list)
+    print(f"netlist stitched, {time.monotonic() - t_start:.1f} s in total")
+
+    if args.check:
+        return check_netlist(args, top_design, rep_dir, os.path.join(incr_dir, "check.log"),
+                             os.path.join(out_dir, f"{top_design}_yosys.v"))
+    return 0
+
+
+if __name__ == "__main__":
+    try:
+        sys.exit(main())
+    except RuntimeError as e:
+        print(e, file=sys.stderr)
+        sys.exit(1)
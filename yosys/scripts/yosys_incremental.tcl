@@ -0,0 +1,90 @@
+# Copyright (c) 2024 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+# Steps of the incremental synthesis flow, run by scripts/yosys_incremental.py (INCR_STEP):
+#   elaborate  read the design and write it to ${INCR_DIR}/elaborated.il (and the liberty files)
+#   block      synthesize BLOCK_NAME from BLOCK_IN (its kept submodules are blackboxes),
+#              the whole design goes to BLOCK_OUT
+#   stitch     read the netlists listed in STITCH_LIST and write the final netlist and reports
+#   check      compare the netlist CHECK_GATE against CHECK_GOLD (written by the full flow):
+#              cell area of both (stat) and formal equivalence (equiv_make/equiv_induct)
+# The steps are the same as in yosys_synthesis.tcl (see yosys_steps.tcl).
+
+if {[info script] ne ""} {
+    cd "[file dirname [info script]]/../"
+}
+
+source scripts/yosys_common.tcl
+source scripts/init_tech.tcl
+source scripts/yosys_steps.tcl
+
+switch $::env(INCR_STEP) {
+    elaborate {
+        set incr_dir $::env(INCR_DIR)
+        set fh [open ${incr_dir}/liberty.txt w]
+        puts $fh [join $lib_list "\n"]
+        close $fh
+
+        read_design
+        synth_check $top_design
+        yosys write_rtlil ${incr_dir}/elaborated.il
+    }
+    block {
+        set block_name $::env(BLOCK_NAME)
+        yosys read_rtlil $::env(BLOCK_IN)
+        yosys hierarchy -top $block_name
+
+        synth_coarse  $::env(BLOCK_PREFIX)
+        synth_flatten $::env(BLOCK_PREFIX)
+        synth_map
+
+        yosys write_rtlil $::env(BLOCK_OUT)
+    }
+    stitch {
+        set fh [open $::env(STITCH_LIST) r]
+        foreach netlist [split [string trim [read $fh]] "\n"] {
+            yosys read_rtlil $netlist
+        }
+        close $fh
+        yosys hierarchy -top $top_design
+
+        write_netlist $top_design
+    }
+    check {
+        # both netlists are flattened down to the functions of the standard cells, the macros
+        # stay blackboxes; registers (<signal>_reg) and macros are matched by their names
+        foreach {design netlist} [list gold $::env(CHECK_GOLD) gate $::env(CHECK_GATE)] {
+            yosys design -reset
+            foreach lib $lib_list {
+                yosys read_liberty -lib $lib
+            }
+            yosys read_verilog $netlist
+            yosys hierarchy -top $top_design
+            yosys tee -q -o "${rep_dir}/${top_design}_check_${design}.json" \
+                stat -json -top $top_design {*}$liberty_args
+
+            foreach lib $tech_cells {
+                yosys read_liberty -overwrite -ignore_miss_func $lib
+            }
+            yosys flatten
+            yosys rename $top_design $design
+            yosys design -stash $design
+        }
+
+        yosys design -reset
+        foreach lib $tech_macros {
+            yosys read_liberty -lib $lib
+        }
+        yosys design -copy-from gold -as gold gold
+        yosys design -copy-from gate -as gate gate
+        yosys equiv_make gold gate equiv
+        yosys hierarchy -top equiv
+        yosys equiv_simple -seq 5
+        yosys equiv_induct -seq 5
+        yosys tee -o "${rep_dir}/${top_design}_check_equiv.rpt" equiv_status -assert
+    }
+    default {
+        error "unknown INCR_STEP $::env(INCR_STEP)"
+    }
+}
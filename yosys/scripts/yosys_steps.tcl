@@ -0,0 +1,162 @@
+# Copyright (c) 2024 ETH Zurich and University of Bologna.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+# The synthesis flow as a sequence of steps, shared by the full flow (yosys_synthesis.tcl)
+# and the incremental flow (yosys_incremental.tcl, driven by yosys_incremental.py).
+# <name> is the prefix of the reports and temporary files of a step.
+# Requires yosys_common.tcl and init_tech.tcl to be sourced first.
+
+# modules (uniquified by yosys-slang as <module-name>$<instance-name>) whose hierarchy is kept,
+# the incremental flow synthesizes each of them separately
+set keep_hierarchy_modules {
+    croc_soc croc_domain user_domain core_wrap cve2_register_file_ff cve2_cs_registers
+    dmi_jtag dm_top gpio timer_unit reg_uart_wrap soc_ctrl_reg_top perf_counters loop_cache
+    boot_rom user_mac tc_clk* tc_sram_impl cdc_* sync
+}
+
+
+# read and elaborate the SystemVerilog sources
+proc read_design {} {
+    global top_design sv_flist keep_hierarchy_modules
+
+    yosys plugin -i slang.so
+    # default from yosys_common.tcl: top_design=croc_chip; sv_flist=../croc.flist
+    yosys read_slang --top $top_design -F $sv_flist \
+            --compat-mode --keep-hierarchy \
+            --allow-use-before-declare --ignore-unknown-modules
+
+    # preserve hierarchy of selected modules/instances
+    # 't' means type as in select all instances of this type/module
+    # yosys-slang uniquifies all modules with the naming scheme:
+    # <module-name>$<instance-name> -> match for t:<module-name>$$
+    foreach module $keep_hierarchy_modules {
+        yosys setattr -set keep_hierarchy 1 "t:${module}$*"
+    }
+
+    # blackbox modules (applies the *blackbox* attribute)
+    yosys blackbox "t:tc_sram_blackbox$*"
+
+    # map dont_touch attribute commonly applied to output-nets of async regs to keep
+    yosys attrmap -rename dont_touch keep
+    # copy the keep attribute to their driving cells (retain on net for debugging)
+    yosys attrmvcp -copy -attr keep
+}
+
+
+# this section heavily borrows from the yosys synth command:
+# synth - check
+proc synth_check {name} {
+    global rep_dir tmp_dir
+
+    yosys hierarchy -top $name
+    yosys check
+    yosys proc
+    yosys tee -q -o "${rep_dir}/${name}_elaborated.rpt" stat
+    yosys write_verilog -norename -noexpr -attr2comment ${tmp_dir}/${name}_yosys_elaborated.v
+}
+
+
+# synth - coarse:
+# similar to yosys synth -run coarse -noalumacc
+proc synth_coarse {name} {
+    global rep_dir tmp_dir
+
+    yosys opt_expr
+    yosys opt -noff
+    yosys fsm
+    yosys tee -q -o "${rep_dir}/${name}_initial_opt.rpt" stat
+    yosys wreduce
+    yosys peepopt
+    yosys opt_clean
+    yosys opt -full
+    yosys booth
+    yosys share
+    yosys opt
+    yosys memory -nomap
+    yosys tee -q -o "${rep_dir}/${name}_memories.rpt" stat
+    yosys write_verilog -norename -noexpr -attr2comment ${tmp_dir}/${name}_yosys_memories.v
+    yosys memory_map
+    yosys opt -fast
+
+    yosys opt_dff -sat -nodffe -nosdff
+    yosys share
+    yosys opt -full
+    yosys clean -purge
+
+    yosys write_verilog -norename ${tmp_dir}/${name}_yosys_abstract.v
+    yosys tee -q -o "${rep_dir}/${name}_abstract.rpt" stat -tech cmos
+
+    yosys techmap
+    yosys opt -fast
+    yosys clean -purge
+
+    yosys tee -q -o "${rep_dir}/${name}_generic.rpt" stat -tech cmos
+    yosys tee -q -o "${rep_dir}/${name}_generic.json" stat -json -tech cmos
+}
+
+
+# flatten all hierarchy except marked modules and fix the names
+proc synth_flatten {name} {
+    global rep_dir
+
+    yosys flatten
+
+    yosys clean -purge
+
+    # Preserve flip-flop names as far as possible
+    # split internal nets
+    yosys splitnets -format __v
+    # rename DFFs from the driven signal
+    yosys rename -wire -suffix _reg t:*DFF*
+    yosys select -write ${rep_dir}/${name}_registers.rpt t:*DFF*
+    # rename all other cells
+    yosys autoname t:*DFF* %n
+    yosys clean -purge
+
+    # print paths to important instances (hierarchy and naming is final here)
+    yosys select -write ${rep_dir}/${name}_registers.rpt t:*DFF*
+    yosys tee -q -o ${rep_dir}/${name}_instances.rpt  select -list "t:RM_IHPSG13_*"
+    yosys tee -q -a ${rep_dir}/${name}_instances.rpt  select -list "t:tc_clk*$*"
+}
+
+
+# mapping to technology
+proc synth_map {} {
+    global tech_cells_args
+
+    # first map flip-flops
+    yosys dfflibmap {*}$tech_cells_args
+
+    # then perform bit-level optimization and mapping on all combinational clouds in ABC
+    # target period (per optimized block/module) in picoseconds
+    set period_ps 10000
+    # pre-process abc file (written to tmp directory)
+    set abc_comb_script   [processAbcScript scripts/abc-opt.script]
+    # call ABC
+    yosys abc {*}$tech_cells_args -D $period_ps -script $abc_comb_script -constr src/abc.constr -showtmp
+
+    yosys clean -purge
+}
+
+
+# prep for openROAD
+proc write_netlist {name} {
+    global rep_dir out_dir tech_cells_args liberty_args tech_cell_tiehi tech_cell_tielo
+
+    yosys write_verilog -norename -noexpr -attr2comment ${out_dir}/${name}_yosys_debug.v
+
+    yosys splitnets -ports -format __v
+    yosys setundef -zero
+    yosys clean -purge
+    # map constants to tie cells
+    yosys hilomap -singleton -hicell {*}$tech_cell_tiehi -locell {*}$tech_cell_tielo
+
+    # final reports
+    yosys tee -q -o "${rep_dir}/${name}_synth.rpt" check
+    yosys tee -q -o "${rep_dir}/${name}_area.rpt" stat -top $name {*}$liberty_args
+    yosys tee -q -o "${rep_dir}/${name}_area_logic.rpt" stat -top $name {*}$tech_cells_args
+
+    # final netlist
+    yosys write_verilog -noattr -noexpr -nohex -nodec ${out_dir}/${name}_yosys.v
+}
@@ -7,6 +7,7 @@
 
 # Tools
 YOSYS    ?= yosys
+PYTHON3  ?= python3
 
 # Directories
 # directory of the path to the last called Makefile (this one)
@@ -14,6 +15,8 @@ YOSYS_DIR 		:= $(realpath $(dir $(realpath $(lastword $(MAKEFILE_LIST)))))
 YOSYS_OUT		:= $(YOSYS_DIR)/out
 YOSYS_TMP		:= $(YOSYS_DIR)/tmp
 YOSYS_REPORTS	:= $(YOSYS_DIR)/reports
+# mapped netlists of the incremental flow, kept across ys_clean
+YOSYS_CACHE		?= $(YOSYS_DIR)/cache
 
 # top level to be synthesized
 TOP_DESIGN		?= croc_chip
@@ -45,10 +48,51 @@ $(NETLIST) $(NETLIST_DEBUG):  $(SV_FLIST)
 		     | gawk -f $(YOSYS_DIR)/scripts/filter_output.awk;
 		
 
+# Incremental flow: each module with kept hierarchy is synthesized on its own (YOSYS_JOBS in
+# parallel) and only when its elaborated RTL or the flow changed (see scripts/yosys_incremental.py)
+YOSYS_JOBS		?= $(shell nproc)
+YOSYS_INCR_ARGS	?=
+
+## Synthesize netlist using Yosys, module by module, reusing the netlists of unchanged modules
+yosys-incr: $(SV_FLIST)
+	@mkdir -p $(YOSYS_OUT)
+	@mkdir -p $(YOSYS_TMP)
+	@mkdir -p $(YOSYS_REPORTS)
+	cd $(YOSYS_DIR) && \
+	SV_FLIST="$(SV_FLIST)" \
+	TOP_DESIGN="$(TOP_DESIGN)" \
+	TMP="$(YOSYS_TMP)" \
+	OUT="$(YOSYS_OUT)" \
+	REPORTS="$(YOSYS_REPORTS)" \
+	$(PYTHON3) $(YOSYS_DIR)/scripts/yosys_incremental.py --yosys $(YOSYS) -j $(YOSYS_JOBS) \
+		--cache $(YOSYS_CACHE) $(YOSYS_INCR_ARGS)
+
+# The incremental netlist is not byte-identical to the one of `make yosys`, yosys-incr-check
+# synthesizes the design with both flows and checks that the netlists are formally equivalent
+# and that their cell area agrees (YOSYS_INCR_ARGS=--area-tolerance <percent>, default 1)
+YOSYS_REF		:= $(YOSYS_TMP)/reference
+
+## Synthesize netlist incrementally and check it against the full flow (equivalence, area)
+yosys-incr-check: $(SV_FLIST)
+	@mkdir -p $(YOSYS_REF)/out
+	@mkdir -p $(YOSYS_REF)/tmp
+	@mkdir -p $(YOSYS_REF)/reports
+	cd $(YOSYS_DIR) && \
+	SV_FLIST="$(SV_FLIST)" \
+	TOP_DESIGN="$(TOP_DESIGN)" \
+	TMP="$(YOSYS_REF)/tmp" \
+	OUT="$(YOSYS_REF)/out" \
+	REPORTS="$(YOSYS_REF)/reports" \
+	$(YOSYS) -c $(YOSYS_DIR)/scripts/yosys_synthesis.tcl > $(YOSYS_REF)/$(TOP_DESIGN).log 2>&1
+	$(MAKE) yosys-incr YOSYS_INCR_ARGS="$(YOSYS_INCR_ARGS) --check $(YOSYS_REF)/out/$(TOP_DESIGN)_yosys.v"
+
 ys_clean:
 	rm -rf $(YOSYS_OUT)
 	rm -rf $(YOSYS_TMP)
 	rm -rf $(YOSYS_REPORTS) 
 	rm -f $(YOSYS_DIR)/$(TOP_DESIGN).log
 
-.PHONY: ys_clean yosys
+ys_clean_cache:
+	rm -rf $(YOSYS_CACHE)
+
+.PHONY: ys_clean ys_clean_cache yosys yosys-incr yosys-incr-check